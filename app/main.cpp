@@ -1,8 +1,10 @@
 #include <YetAnotherMlp/MLPTrainer.hpp>
 #include <YetAnotherMlp/Mnist.hpp>
+#include <YetAnotherMlp/TripleBuffer.hpp>
 
 #include <SFML/Graphics.hpp>
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -31,6 +33,7 @@ struct HeatMap: sf::Drawable, sf::Transformable {
         resolution_ = resolution;
         size_ = size;
 
+        layout();
         update(values);
     }
 
@@ -39,6 +42,7 @@ struct HeatMap: sf::Drawable, sf::Transformable {
         target.draw(rects_, states);
     }
 
+    // recolors the quads in place, vertices are laid out once in the constructor
     template<std::ranges::forward_range Values>
     requires(std::floating_point<std::ranges::range_value_t<Values>>)
     void update(Values&& values) {
@@ -47,37 +51,44 @@ struct HeatMap: sf::Drawable, sf::Transformable {
         const auto min = std::ranges::min(values);
         const auto max = std::ranges::max(values);
         const auto range = std::max(std::fabs(max - min), decltype(max)(1));
+        const auto quads = rects_.getVertexCount() / 4;
+
+        for(const auto [i, value] : zip(iota(0u), values | take(quads))) {
+            const auto brightness = 255.0f * (value - min) / range;
+            const auto color = sf::Color(brightness, brightness, brightness);
+
+            rects_[i * 4 + 0].color = color;
+            rects_[i * 4 + 1].color = color;
+            rects_[i * 4 + 2].color = color;
+            rects_[i * 4 + 3].color = color;
+        }
+    }
+
+private:
+    void layout() {
         const auto rectSize = sf::Vector2f { 
             size_.x / resolution_.x, 
             size_.y / resolution_.y 
         };
 
-        for(const auto [i, value] : zip(iota(0), values)) {
+        for (auto i = 0u; i < resolution_.x * resolution_.y; ++i) {
             const auto row = i / resolution_.x;
             const auto col = i % resolution_.x;
-            const auto brightness = 255.0f * (value - min) / range;
-            const auto color = sf::Color(brightness, brightness, brightness);
 
             rects_[i * 4 + 0].position = {rectSize.x * (col + 0), rectSize.y * (row + 0)};
             rects_[i * 4 + 1].position = {rectSize.x * (col + 1), rectSize.y * (row + 0)};
             rects_[i * 4 + 2].position = {rectSize.x * (col + 1), rectSize.y * (row + 1)};
             rects_[i * 4 + 3].position = {rectSize.x * (col + 0), rectSize.y * (row + 1)};
-
-            rects_[i * 4 + 0].color = color;
-            rects_[i * 4 + 1].color = color;
-            rects_[i * 4 + 2].color = color;
-            rects_[i * 4 + 3].color = color;
         }
     }
 
-private:
     sf::VertexArray rects_;
     sf::Vector2u resolution_;
     sf::Vector2f size_;
 };
 
-auto mnistTrainer() -> yam::MLPTrainer {
-        const auto trainset = yam::Mnist::read(
+auto mnistTrainer(yam::MLPTrainer::Options options) -> yam::MLPTrainer {
+    const auto trainset = yam::Mnist::read(
         "../resources/train-images.idx3-ubyte", 
         "../resources/train-labels.idx1-ubyte"
     );
@@ -93,7 +104,7 @@ auto mnistTrainer() -> yam::MLPTrainer {
         yam::Activation::sigmoid
     );
 
-    return yam::MLPTrainer(mlp, 0.1, 0.035, 20, trainset, testset, yam::Derivation::sigmoid);
+    return yam::MLPTrainer(mlp, 0.1, 0.035, 20, trainset, testset, yam::Derivation::sigmoid, options);
 }
 
 auto heatMaps(const yam::MLPerceptron& mlp) -> std::vector<HeatMap> {
@@ -116,24 +127,39 @@ auto heatMaps(const yam::MLPerceptron& mlp) -> std::vector<HeatMap> {
 }
 
 int main() {
-    // std::cout << "iteration: " << result.epoch << ", error: " << result.error << "\n";
-    auto trainer = mnistTrainer();
+    // weights published by the training thread, also in the middle of epochs
+    auto snapshots = yam::TripleBuffer<std::vector<float>>();
+    const auto publishEvery = 5000;
+
+    auto trainer = mnistTrainer({
+        .synchronize = [&snapshots](const yam::MLPerceptron& mlp, bool) {
+            snapshots.back().assign(mlp.weights().begin(), mlp.weights().end());
+            snapshots.publish();
+        },
+        .synchronizeEvery = publishEvery
+    });
+
     auto first = trainer.begin();
     auto mlp = *first->trainee;
     auto heatMaps = ::heatMaps(mlp);
+    const auto layerSize = mlp.topology()[mlp.topology().size() - 2];
 
-    const auto interval = std::chrono::seconds(2);
-
-    auto time = std::chrono::high_resolution_clock::now();
-
-    for (auto window = ::window(); window->isOpen(); window->display()) {
-        const auto now = std::chrono::high_resolution_clock::now();
-        if ((now - time > interval) && !first->isTrained()) {
-            time = now;
+    // stops after the epoch in progress
+    auto stop = std::atomic<bool>(false);
+    auto training = std::thread([&] {
+        while (!stop && !first->isTrained()) {
             ++first;
             const auto result = *first;
             std::cout << "iteration: " << result.epoch << ", error: " << result.error << "\n";
-            heatMaps = ::heatMaps(*first->trainee);
+        }
+    });
+
+    for (auto window = ::window(); window->isOpen(); window->display()) {
+        if (snapshots.update()) {
+            const auto weights = std::span(snapshots.front());
+            for (auto d = 0; d < heatMaps.size(); ++d) {
+                heatMaps[d].update(weights.subspan(d * layerSize, layerSize));
+            }
         }
 
         for (auto event = sf::Event(); window->pollEvent(event);) {
@@ -143,9 +169,12 @@ int main() {
         }
 
         window->clear();
-        for (const auto map : heatMaps) {
+        for (const auto& map : heatMaps) {
             window->draw(map);
         }
     }
+
+    stop = true;
+    training.join();
     return 0;
-}
\ No newline at end of file
+}
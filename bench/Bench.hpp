@@ -0,0 +1,92 @@
+#pragma once
+
+#include <YetAnotherMlp/Dataset.hpp>
+#include <YetAnotherMlp/Mnist.hpp>
+#include <YetAnotherMlp/Random.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <ranges>
+#include <utility>
+
+namespace bench {
+
+// average seconds per call
+template<typename Callable>
+auto measure(Callable&& callable, int repeats = 1) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    for (auto r = 0; r < repeats; ++r) {
+        callable();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count() / repeats;
+}
+
+// mnist-like classification problem: every class is a sparse prototype image,
+// prototypes depend only on the shape so that datasets with different seeds match
+inline auto synthetic(
+    int samples, 
+    int inputs, 
+    int classes, 
+    std::uint32_t seed
+) -> yam::Dataset {
+    auto shape = yam::Random(inputs * classes);
+    auto random = yam::Random(seed);
+
+    auto prototypes = std::vector<float>(inputs * classes);
+    for (auto& pixel : prototypes) {
+        pixel = shape(0.0f, 1.0f) < 0.2f ? shape(0.5f, 1.0f) : 0.0f;
+    }
+
+    auto in = std::vector<float>(samples * inputs);
+    auto out = std::vector<float>(samples * classes);
+
+    for (auto s = 0; s < samples; ++s) {
+        const auto label = random(0, classes - 1);
+        const auto prototype = prototypes.begin() + label * inputs;
+
+        for (auto i = 0; i < inputs; ++i) {
+            const auto flip = random(0.0f, 1.0f) < 0.03f;
+            in[s * inputs + i] = flip ? random(0.0f, 1.0f) * (prototype[i] == 0) : prototype[i];
+        }
+        out[s * classes + label] = 1;
+    }
+
+    return yam::Dataset(std::move(in), std::move(out), samples);
+}
+
+// real mnist when ../resources holds it, synthetic stand-in otherwise
+inline auto mnist() -> std::pair<yam::Dataset, yam::Dataset> {
+    const auto files = {
+        "../resources/train-images.idx3-ubyte", 
+        "../resources/train-labels.idx1-ubyte",
+        "../resources/t10k-images.idx3-ubyte", 
+        "../resources/t10k-labels.idx1-ubyte"
+    };
+
+    if (std::ranges::all_of(files, [](auto f) { return std::filesystem::exists(f); })) {
+        return {
+            yam::Mnist::read(files.begin()[0], files.begin()[1]),
+            yam::Mnist::read(files.begin()[2], files.begin()[3])
+        };
+    }
+
+    std::cout << "mnist not found in ../resources, using synthetic dataset\n";
+    return { synthetic(20000, 784, 10, 1), synthetic(2000, 784, 10, 2) };
+}
+
+template<typename Model>
+auto accuracy(Model& model, const yam::Dataset& dataset) -> float {
+    auto correct = 0;
+    for (auto i = 0; i < dataset.size(); ++i) {
+        const auto actual = model.forward(dataset.input(i).data());
+        const auto expected = dataset.output(i);
+        correct += std::ranges::max_element(actual) - actual.begin()
+            == std::ranges::max_element(expected) - expected.begin();
+    }
+    return dataset.size() ? float(correct) / dataset.size() : 0;
+}
+
+}
@@ -0,0 +1,36 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/MLPTrainer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+// deep and wide network, state of backpropagation against epoch time
+TEST(BenchCheckpointing, MemoryAgainstTime) {
+    const auto [trainset, testset] = bench::mnist();
+    const auto subset = bench::synthetic(200, trainset.inputSize(), trainset.outputSize(), 1);
+
+    auto topology = std::vector<int> { trainset.inputSize() };
+    topology.insert(topology.end(), 32, 256);
+    topology.push_back(trainset.outputSize());
+
+    const auto prototype = yam::MLPerceptron(topology, true, {yam::ActivationFunctionType::Tanh});
+
+    std::cout << std::setw(18) << "checkpoint every"
+              << std::setw(14) << "state [KB]"
+              << std::setw(14) << "epoch [s]" << "\n";
+
+    for (const auto every : {0, 1, 2, 4, 6, 11, 33}) {
+        auto trainer = yam::MLPTrainer(prototype, 0.01, 0.0, 1, subset, subset, {
+            .seed = 1,
+            .checkpointEvery = every
+        });
+
+        const auto seconds = bench::measure([&] { trainer.train(); });
+
+        std::cout << std::setw(18) << every
+                  << std::setw(14) << trainer.stateBytes() / 1024.0
+                  << std::setw(14) << seconds << "\n";
+    }
+}
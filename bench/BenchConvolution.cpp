@@ -0,0 +1,55 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/Convolution.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+// parameters, multiply-adds per sample, epoch time and accuracy of a dense
+// first layer against a convolutional front end on 28 x 28 images
+TEST(BenchConvolution, DenseAgainstConvolutional) {
+    const auto [trainset, testset] = bench::mnist();
+    const auto train = bench::synthetic(5000, trainset.inputSize(), trainset.outputSize(), 3);
+
+    auto dense = yam::MLPerceptron({784, 128, 10}, true, {
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    auto convolution = yam::Convolution({ .width = 28, .height = 28, .filters = 8, .kernel = 5, .pool = 4 });
+    auto convolutional = yam::MLPerceptron({convolution.outputSize(), 64, 10}, true, {
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+    convolutional.convolution(convolution);
+
+    std::cout << std::setw(16) << "network"
+              << std::setw(14) << "parameters"
+              << std::setw(14) << "MACs"
+              << std::setw(14) << "epoch [s]"
+              << std::setw(14) << "accuracy" << "\n";
+
+    const auto run = [&](const char* name, const yam::MLPerceptron& mlp, int parameters, int macs) {
+        auto trainer = yam::MLPTrainer(mlp, 0.01, 0.0, 3, train, testset, {
+            .seed = 1,
+            .initialization = yam::Initialization::He
+        });
+
+        auto result = yam::MLPTrainer::Result();
+        const auto seconds = bench::measure([&] { result = trainer.train(); });
+
+        std::cout << std::setw(16) << name
+                  << std::setw(14) << parameters
+                  << std::setw(14) << macs
+                  << std::setw(14) << seconds / 3
+                  << std::setw(14) << result.evaluation.accuracy() << "\n";
+    };
+
+    run("dense", dense, dense.weights().size() + dense.biases().size(), dense.weights().size());
+    run("convolutional", convolutional,
+        convolutional.weights().size() + convolutional.biases().size() + 8 * 25 + 8,
+        convolutional.weights().size() + 8 * 25 * 24 * 24
+    );
+}
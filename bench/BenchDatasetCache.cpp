@@ -0,0 +1,56 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/DatasetCache.hpp>
+#include <YetAnotherMlp/Idx.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+// startup of a run on an mnist sized trainset: parsing idx files against
+// mapping the cache, with and without checksum verification
+TEST(BenchDatasetCache, ParsingAgainstMapping) {
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto images = (directory / "yam-bench-images.idx").string();
+    const auto labels = (directory / "yam-bench-labels.idx").string();
+    const auto cache = (directory / "yam-bench.cache").string();
+
+    const auto samples = 60000;
+    const auto dataset = bench::synthetic(samples, 784, 10, 1);
+
+    auto pixels = std::vector<float>(dataset.inputs().begin(), dataset.inputs().end());
+    std::ranges::transform(pixels, pixels.begin(), [](float p) { return p * 255.0f; });
+
+    auto classes = std::vector<float>(samples);
+    for (auto s = 0; s < samples; ++s) {
+        classes[s] = std::ranges::max_element(dataset.output(s)) - dataset.output(s).begin();
+    }
+
+    ASSERT_TRUE(yam::Idx::write(images.c_str(), yam::IdxType::UInt8, std::vector<std::uint32_t> { samples, 28, 28 }, pixels));
+    ASSERT_TRUE(yam::Idx::write(labels.c_str(), yam::IdxType::UInt8, std::vector<std::uint32_t> { samples }, classes));
+    ASSERT_TRUE(yam::DatasetCache::save(yam::Mnist::read(images.c_str(), labels.c_str()), cache.c_str()));
+
+    std::cout << std::setw(28) << "loading"
+              << std::setw(14) << "time [ms]" << "\n";
+
+    const auto print = [](const char* name, double seconds) {
+        std::cout << std::setw(28) << name << std::setw(14) << seconds * 1e3 << "\n";
+    };
+
+    // touching every input stands in for the first epoch paging the mapping in
+    auto sum = 0.0f;
+    const auto touch = [&sum](const yam::Dataset& dataset) {
+        for (auto s = 0; s < dataset.size(); ++s) {
+            sum += dataset.input(s)[0];
+        }
+    };
+
+    print("Mnist::read", bench::measure([&] { touch(yam::Mnist::read(images.c_str(), labels.c_str())); }, 3));
+    print("DatasetCache::load", bench::measure([&] { touch(*yam::DatasetCache::load(cache.c_str())); }, 3));
+    print("DatasetCache::load, no verify", bench::measure([&] { touch(*yam::DatasetCache::load(cache.c_str(), false)); }, 3));
+    std::cout << "(" << sum << ")\n";
+
+    std::filesystem::remove(images);
+    std::filesystem::remove(labels);
+    std::filesystem::remove(cache);
+}
@@ -0,0 +1,72 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/Distributed.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// one epoch over the whole trainset split among local processes, rank 0 reports
+TEST(BenchDistributed, DataParallelScaling) {
+    const auto [trainset, testset] = bench::mnist();
+
+    const auto prototype = yam::MLPerceptron(
+        {trainset.inputSize(), 64, trainset.outputSize()},
+        true,
+        {yam::ActivationFunctionType::Sigmoid}
+    );
+
+    std::cout << std::setw(10) << "processes"
+              << std::setw(10) << "overlap"
+              << std::setw(14) << "epoch [s]"
+              << std::setw(14) << "samples/s"
+              << std::setw(14) << "error" << "\n";
+
+    auto port = static_cast<std::uint16_t>(20000 + ::getpid() % 20000);
+
+    for (const auto processes : {1, 2, 4, 8}) {
+        for (const auto overlap : {false, true}) {
+            const auto run = [&, port](int rank) {
+                auto ring = yam::Ring(rank, processes, port);
+                auto parallel = yam::DataParallel(ring, overlap);
+                auto trainer = yam::MLPTrainer(
+                    prototype, 0.1, 0.0, 1, yam::shard(trainset, rank, processes), testset, {
+                        .seed = 1,
+                        .synchronize = std::ref(parallel),
+                        .synchronizeEvery = 256
+                    }
+                );
+
+                auto error = 0.0f;
+                const auto seconds = bench::measure([&] { error = trainer.train().error; });
+                return std::make_pair(seconds, error);
+            };
+
+            auto children = std::vector<pid_t>();
+            for (auto rank = 1; rank < processes; ++rank) {
+                const auto pid = ::fork();
+                if (pid == 0) {
+                    run(rank);
+                    ::_exit(0);
+                }
+                children.push_back(pid);
+            }
+
+            const auto [seconds, error] = run(0);
+            for (const auto pid : children) {
+                ::waitpid(pid, nullptr, 0);
+            }
+            port += processes;
+
+            std::cout << std::setw(10) << processes
+                      << std::setw(10) << overlap
+                      << std::setw(14) << seconds
+                      << std::setw(14) << trainset.size() / processes * processes / seconds
+                      << std::setw(14) << error << "\n";
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/EnsembleTrainer.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+TEST(BenchEnsembleTrainer, SweepThroughput) {
+    const auto [trainset, testset] = bench::mnist();
+
+    const auto prototype = yam::MLPerceptron(
+        {trainset.inputSize(), 32, trainset.outputSize()}, 
+        true, 
+        {yam::ActivationFunctionType::Sigmoid}
+    );
+
+    std::cout << std::setw(8) << "models"
+              << std::setw(20) << "separate [s/model]"
+              << std::setw(20) << "ensemble [s/model]"
+              << std::setw(10) << "speedup" << "\n";
+
+    for (const auto models : {1, 4, 8, 16}) {
+        auto learnrates = std::vector<float>(models);
+        auto seeds = std::vector<std::uint32_t>(models);
+        for (auto k = 0; k < models; ++k) {
+            learnrates[k] = 0.05f * (k + 1);
+            seeds[k] = k;
+        }
+
+        const auto separate = bench::measure([&] {
+            for (auto k = 0; k < models; ++k) {
+                auto trainer = yam::MLPTrainer(prototype, learnrates[k], 0.0, 1, trainset, testset, {
+                    .seed = seeds[k]
+                });
+                trainer.train();
+            }
+        }) / models;
+
+        auto ensemble = yam::EnsembleTrainer(prototype, learnrates, seeds, trainset, testset);
+        const auto lockstep = bench::measure([&] { ensemble.epoch(); }) / models;
+
+        std::cout << std::setw(8) << models
+                  << std::setw(20) << separate
+                  << std::setw(20) << lockstep
+                  << std::setw(10) << separate / lockstep << "\n";
+    }
+}
@@ -0,0 +1,36 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/Initialization.hpp>
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/ThreadPool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+// a few million weights, one value at a time through mt19937 against
+// Philox blocks
+TEST(BenchInitialization, SeparatedAgainstBulk) {
+    auto mlp = yam::MLPerceptron({784, 2048, 2048, 10}, true, {yam::ActivationFunctionType::Relu});
+    auto pool = yam::ThreadPool();
+
+    std::cout << mlp.weights().size() << " weights\n"
+              << std::setw(28) << "initialization"
+              << std::setw(14) << "time [ms]" << "\n";
+
+    const auto print = [](const char* name, double seconds) {
+        std::cout << std::setw(28) << name << std::setw(14) << seconds * 1e3 << "\n";
+    };
+
+    auto random = yam::Random(1);
+    print("Random::separated", bench::measure([&] {
+        random.separated(0.3f, 0.2f, mlp.weights());
+        random.separated(0.3f, 0.2f, mlp.biases());
+    }, 3));
+
+    print("Separated", bench::measure([&] { yam::initialize(mlp, yam::Initialization::Separated, 1); }, 3));
+    print("Xavier", bench::measure([&] { yam::initialize(mlp, yam::Initialization::Xavier, 1); }, 3));
+    print("He", bench::measure([&] { yam::initialize(mlp, yam::Initialization::He, 1); }, 3));
+    print("Xavier, pool", bench::measure([&] { yam::initialize(mlp, yam::Initialization::Xavier, 1, &pool); }, 3));
+    print("He, pool", bench::measure([&] { yam::initialize(mlp, yam::Initialization::He, 1, &pool); }, 3));
+}
@@ -0,0 +1,48 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/MLPTrainer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+TEST(BenchShuffling, EpochPerStrategy) {
+    const auto [trainset, testset] = bench::mnist();
+
+    const auto strategies = {
+        std::make_pair("samples", yam::Shuffling::Samples),
+        std::make_pair("blocks", yam::Shuffling::Blocks),
+        std::make_pair("staged", yam::Shuffling::Staged)
+    };
+
+    std::cout << std::setw(10) << "hidden"
+              << std::setw(10) << "strategy"
+              << std::setw(12) << "epoch [s]"
+              << std::setw(16) << "samples/s" 
+              << std::setw(14) << "error" << "\n";
+
+    for (const auto hidden : {0, 100}) {
+        auto topology = std::vector { trainset.inputSize(), trainset.outputSize() };
+        if (hidden) {
+            topology.insert(topology.begin() + 1, hidden);
+        }
+
+        const auto mlp = yam::MLPerceptron(topology, true, {yam::ActivationFunctionType::Sigmoid});
+
+        for (const auto [name, shuffling] : strategies) {
+            // two epochs minus one: the first one warms up staging buffers
+            auto once = yam::MLPTrainer(mlp, 0.1, 0.0, 1, trainset, testset, {.shuffling = shuffling});
+            auto twice = yam::MLPTrainer(mlp, 0.1, 0.0, 2, trainset, testset, {.shuffling = shuffling});
+
+            auto error = 0.0f;
+            const auto time = bench::measure([&] { error = twice.train().error; }) 
+                            - bench::measure([&] { once.train(); });
+
+            std::cout << std::setw(10) << hidden
+                      << std::setw(10) << name
+                      << std::setw(12) << time
+                      << std::setw(16) << trainset.size() / time
+                      << std::setw(14) << error << "\n";
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Simd.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+// kernels of every supported instruction set on mnist sized layers, and
+// a dense training epoch with each of them selected
+TEST(BenchSimd, KernelsAndTrainingPerIsa) {
+    const auto [trainset, testset] = bench::mnist();
+    const auto lc = 784;
+    const auto uc = 100;
+
+    auto random = yam::Random(1);
+    auto weights = std::vector<float>(lc * uc);
+    auto lower = std::vector<float>(lc);
+    auto upper = std::vector<float>(uc);
+    random(-1.0f, 1.0f, weights);
+    random(-1.0f, 1.0f, lower);
+    random(-1.0f, 1.0f, upper);
+
+    std::cout << std::setw(10) << "isa"
+              << std::setw(14) << "dot [us]"
+              << std::setw(14) << "axpy [us]"
+              << std::setw(18) << "transposed [us]"
+              << std::setw(14) << "samples/s" << "\n";
+
+    const auto best = yam::Simd::best();
+
+    for (const auto [isa, name] : {
+        std::pair(yam::Isa::Scalar, "scalar"),
+        std::pair(yam::Isa::Sse4, "sse4"),
+        std::pair(yam::Isa::Avx2, "avx2"),
+        std::pair(yam::Isa::Avx512, "avx512")
+    }) {
+        if (!yam::Simd::select(isa)) {
+            continue;
+        }
+        const auto& kernels = yam::Simd::active();
+
+        // a forward, a correction and an error propagation of the layer
+        const auto dot = bench::measure([&] {
+            for (auto u = 0; u < uc; ++u) {
+                upper[u] = kernels.dot(weights.data() + u * lc, lower.data(), lc);
+            }
+        }, 1000);
+        const auto axpy = bench::measure([&] {
+            for (auto u = 0; u < uc; ++u) {
+                kernels.axpy(1e-6f * upper[u], lower.data(), weights.data() + u * lc, lc);
+            }
+        }, 1000);
+        const auto transposed = bench::measure([&] {
+            kernels.transposedMatmul(weights.data(), upper.data(), lower.data(), uc, lc);
+        }, 1000);
+
+        auto trainer = yam::MLPTrainer(
+            yam::MLPerceptron({trainset.inputSize(), uc, trainset.outputSize()}, true, {yam::ActivationFunctionType::Sigmoid}),
+            0.1f, 0.0f, 1, trainset, testset, { .seed = 1 }
+        );
+        trainer.trainee().sparseDensity(0.0f);
+        const auto epoch = bench::measure([&] { trainer.train(); });
+
+        std::cout << std::setw(10) << name
+                  << std::setw(14) << dot * 1e6
+                  << std::setw(14) << axpy * 1e6
+                  << std::setw(18) << transposed * 1e6
+                  << std::setw(14) << trainset.size() / epoch << "\n";
+    }
+
+    yam::Simd::select(best);
+}
@@ -0,0 +1,90 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Sparse.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+TEST(BenchSparse, SparsityAccuracySpeed) {
+    const auto [trainset, testset] = bench::mnist();
+
+    auto mlp = yam::MLPerceptron(
+        {trainset.inputSize(), 100, trainset.outputSize()}, 
+        true, 
+        {yam::ActivationFunctionType::Sigmoid}
+    );
+
+    auto trainer = yam::MLPTrainer(mlp, 0.1, 0.0, 3, trainset, testset);
+    trainer.train();
+
+    const auto batch = 64;
+    const auto batches = testset.size() / batch;
+    const auto dense = trainer.trainee();
+
+    std::cout << std::setw(10) << "sparsity" 
+              << std::setw(10) << "accuracy" 
+              << std::setw(14) << "dense [us]" 
+              << std::setw(14) << "sparse [us]"
+              << std::setw(16) << "sparse batch"
+              << std::setw(12) << "dense [kB]"
+              << std::setw(12) << "sparse [kB]" << "\n";
+
+    for (const auto sparsity : {0.0f, 0.5f, 0.7f, 0.8f, 0.9f, 0.95f, 0.98f}) {
+        auto pruned = dense;
+        yam::pruneFraction(pruned, sparsity);
+
+        auto sparse = yam::SparseMLPerceptron(pruned);
+
+        const auto accuracy = bench::accuracy(pruned, testset);
+
+        const auto denseTime = bench::measure([&] {
+            for (auto i = 0; i < testset.size(); ++i) {
+                pruned.forward(testset.input(i).data());
+            }
+        }) / testset.size();
+
+        const auto sparseTime = bench::measure([&] {
+            for (auto i = 0; i < testset.size(); ++i) {
+                sparse.forward(testset.input(i).data());
+            }
+        }) / testset.size();
+
+        const auto batchTime = bench::measure([&] {
+            for (auto b = 0; b < batches; ++b) {
+                sparse.forward(testset.input(b * batch).data(), batch);
+            }
+        }) / (batches * batch);
+
+        std::cout << std::setw(10) << sparse.sparsity()
+                  << std::setw(10) << accuracy
+                  << std::setw(14) << denseTime * 1e6
+                  << std::setw(14) << sparseTime * 1e6
+                  << std::setw(16) << batchTime * 1e6
+                  << std::setw(12) << (pruned.weights().size() + pruned.biases().size()) * sizeof(float) / 1024
+                  << std::setw(12) << sparse.bytes() / 1024 << "\n";
+    }
+}
+
+TEST(BenchSparse, SparseInputEpoch) {
+    const auto [trainset, testset] = bench::mnist();
+
+    for (const auto density : {0.0f, 0.5f}) {
+        auto mlp = yam::MLPerceptron(
+            {trainset.inputSize(), 100, trainset.outputSize()}, 
+            true, 
+            {yam::ActivationFunctionType::Sigmoid}
+        );
+        mlp.sparseDensity(density);
+
+        auto trainer = yam::MLPTrainer(mlp, 0.1, 0.0, 1, trainset, testset);
+
+        auto error = 0.0f;
+        const auto time = bench::measure([&] { error = trainer.train().error; });
+
+        std::cout << "sparse density " << density 
+                  << ": epoch " << time << " s, "
+                  << trainset.size() / time << " samples/s, error " << error << "\n";
+    }
+}
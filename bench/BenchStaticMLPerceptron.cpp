@@ -0,0 +1,63 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/StaticMLPerceptron.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <memory>
+
+namespace {
+
+template<int... Topology>
+auto compare(const char* name) -> void {
+    using Static = yam::StaticMLPerceptron<yam::Activation::Sigmoid, true, Topology...>;
+
+    auto mlp = yam::MLPerceptron({Topology...}, true, {yam::ActivationFunctionType::Sigmoid});
+    auto random = yam::Random(1);
+    random(-0.1f, 0.1f, mlp.weights());
+    random(-0.1f, 0.1f, mlp.biases());
+
+    auto fixed = std::make_unique<Static>();
+    fixed->load(mlp);
+
+    const auto samples = 1024;
+    auto inputs = std::vector<float>(samples * Static::inputs);
+    random(0.0f, 1.0f, inputs);
+
+    auto sink = 0.0f;
+    const auto repeats = std::max(1, 20'000'000 / (Static::weightCount * samples));
+
+    const auto dynamic = bench::measure([&] {
+        for (auto s = 0; s < samples; ++s) {
+            sink += mlp.forward(inputs.data() + s * Static::inputs)[0];
+        }
+    }, repeats) / samples;
+
+    const auto constant = bench::measure([&] {
+        for (auto s = 0; s < samples; ++s) {
+            sink += fixed->forward(inputs.data() + s * Static::inputs)[0];
+        }
+    }, repeats) / samples;
+
+    std::cout << std::setw(16) << name
+              << std::setw(16) << dynamic * 1e9
+              << std::setw(16) << constant * 1e9
+              << std::setw(10) << dynamic / constant
+              << (sink == 0 ? " " : "") << "\n";
+}
+
+}
+
+TEST(BenchStaticMLPerceptron, ForwardLatency) {
+    std::cout << std::setw(16) << "topology"
+              << std::setw(16) << "dynamic [ns]"
+              << std::setw(16) << "static [ns]"
+              << std::setw(10) << "speedup" << "\n";
+
+    compare<4, 8, 2>("4-8-2");
+    compare<16, 32, 4>("16-32-4");
+    compare<64, 64, 64, 10>("64-64-64-10");
+    compare<784, 100, 10>("784-100-10");
+}
@@ -0,0 +1,98 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/ThreadPool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <thread>
+
+TEST(BenchThreadPool, EpochScaling) {
+    const auto [trainset, testset] = bench::mnist();
+
+    const auto mlp = yam::MLPerceptron(
+        {trainset.inputSize(), 100, trainset.outputSize()}, 
+        true, 
+        {yam::ActivationFunctionType::Sigmoid}
+    );
+
+    const auto evaluate = [&](yam::MLPTrainer::Options options) {
+        // zero epochs: weights initialization and a single evaluation of testset
+        auto trainer = yam::MLPTrainer(mlp, 0.1, 0.0, 0, trainset, testset, options);
+        return bench::measure([&] { trainer.train(); }, 3);
+    };
+
+    const auto epoch = [&](yam::MLPTrainer::Options options) {
+        auto trainer = yam::MLPTrainer(mlp, 0.1, 0.0, 1, trainset, testset, options);
+        return bench::measure([&] { trainer.train(); });
+    };
+
+    const auto serialEvaluation = evaluate({});
+    const auto serialEpoch = epoch({});
+
+    std::cout << std::setw(10) << "threads"
+              << std::setw(16) << "evaluation [s]"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "epoch [s]"
+              << std::setw(10) << "speedup" << "\n";
+
+    std::cout << std::setw(10) << "serial"
+              << std::setw(16) << serialEvaluation
+              << std::setw(10) << 1
+              << std::setw(12) << serialEpoch
+              << std::setw(10) << 1 << "\n";
+
+    for (auto threads = 1; threads <= std::max(8u, std::thread::hardware_concurrency()); threads *= 2) {
+        auto pool = yam::ThreadPool(threads);
+
+        const auto evaluation = evaluate({.pool = &pool});
+        const auto time = epoch({.pool = &pool});
+
+        std::cout << std::setw(10) << threads
+                  << std::setw(16) << evaluation
+                  << std::setw(10) << serialEvaluation / evaluation
+                  << std::setw(12) << time
+                  << std::setw(10) << serialEpoch / time << "\n";
+    }
+}
+
+TEST(BenchThreadPool, SingleSampleLatency) {
+    auto mlp = yam::MLPerceptron({4096, 4096}, true, {yam::ActivationFunctionType::Relu});
+
+    auto random = yam::Random(1);
+    random(-0.01f, 0.01f, mlp.weights());
+
+    auto input = std::vector<float>(4096);
+    random(-1.0f, 1.0f, input);
+
+    const auto latencies = [&] {
+        auto times = std::vector<double>(50);
+        for (auto& time : times) {
+            time = bench::measure([&] { mlp.forward(input.data()); });
+        }
+        std::ranges::sort(times);
+        return std::make_pair(times[times.size() / 2], times[times.size() * 99 / 100]);
+    };
+
+    std::cout << std::setw(10) << "threads"
+              << std::setw(12) << "p50 [ms]"
+              << std::setw(12) << "p99 [ms]" << "\n";
+
+    const auto [p50, p99] = latencies();
+    std::cout << std::setw(10) << "serial"
+              << std::setw(12) << p50 * 1e3
+              << std::setw(12) << p99 * 1e3 << "\n";
+
+    for (auto threads = 1; threads <= std::max(8u, std::thread::hardware_concurrency()); threads *= 2) {
+        auto pool = yam::ThreadPool(threads);
+        mlp.parallelize(&pool);
+
+        const auto [p50, p99] = latencies();
+        std::cout << std::setw(10) << threads
+                  << std::setw(12) << p50 * 1e3
+                  << std::setw(12) << p99 * 1e3 << "\n";
+    }
+
+    mlp.parallelize(nullptr);
+}
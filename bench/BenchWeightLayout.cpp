@@ -0,0 +1,83 @@
+#include "Bench.hpp"
+
+#include <YetAnotherMlp/Mathematics.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/WeightLayout.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+
+// errors of a 1024 x 1024 layer propagated down: axpy of every row as the
+// trainer did, four rows at a time and over panels
+TEST(BenchWeightLayout, TransposedProduct) {
+    constexpr auto lc = 1024;
+    constexpr auto uc = 1024;
+    constexpr auto repeats = 200;
+
+    const auto topology = std::vector { lc, uc };
+    auto random = yam::Random(1);
+    auto weights = std::vector<float>(lc * uc);
+    auto upper = std::vector<float>(uc);
+    auto lower = std::vector<float>(lc);
+    random(-1.0f, 1.0f, weights);
+    random(-1.0f, 1.0f, upper);
+
+    auto panels = yam::PanelWeights(topology);
+    panels.pack(weights);
+
+    const auto print = [](const char* name, double seconds) {
+        std::cout << std::setw(16) << name
+                  << std::setw(14) << seconds * 1e6
+                  << std::setw(14) << 2.0 * lc * uc / seconds * 1e-9 << "\n";
+    };
+
+    std::cout << std::setw(16) << "kernel"
+              << std::setw(14) << "time [us]"
+              << std::setw(14) << "GFLOP/s" << "\n";
+
+    print("row axpy", bench::measure([&] {
+        std::fill(lower.begin(), lower.end(), 0.0f);
+        auto weight = weights.data();
+        for (auto u = 0; u < uc; ++u) {
+            for (auto l = 0; l < lc; ++l) {
+                lower[l] += *weight++ * upper[u];
+            }
+        }
+    }, repeats));
+
+    print("row-major", bench::measure([&] {
+        yam::transposedMatmul(weights.data(), upper.data(), lower.data(), uc, lc);
+    }, repeats));
+
+    print("panels", bench::measure([&] {
+        panels.transposed(0, upper.data(), lower.data());
+    }, repeats));
+}
+
+// samples per second of a wide network trained on both layouts
+TEST(BenchWeightLayout, TrainingThroughput) {
+    const auto dataset = bench::synthetic(1000, 784, 10, 1);
+    const auto mlp = yam::MLPerceptron({784, 512, 512, 10}, true, {
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    std::cout << std::setw(16) << "layout"
+              << std::setw(14) << "samples/s" << "\n";
+
+    for (const auto [name, layout] : {
+        std::pair { "row-major", yam::WeightLayout::RowMajor },
+        std::pair { "panels", yam::WeightLayout::Panels }
+    }) {
+        auto trainer = yam::MLPTrainer(mlp, 0.01, 0.0, 1, dataset, dataset, {
+            .seed = 1,
+            .weightLayout = layout
+        });
+
+        const auto seconds = bench::measure([&] { trainer.train(); });
+        std::cout << std::setw(16) << name
+                  << std::setw(14) << dataset.size() / seconds << "\n";
+    }
+}
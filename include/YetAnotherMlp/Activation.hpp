@@ -11,7 +11,11 @@ namespace yam {
 enum class ActivationFunctionType {
     Linear,
     Sigmoid,
-    Bisigmoid
+    Bisigmoid,
+    Relu,
+    LeakyRelu,
+    Tanh,
+    Custom // user supplied activation_function, no derivation known
 };
 
 using activation_function = std::function<float*(std::span<const float>, float*)>;
@@ -44,11 +48,44 @@ struct Activation {
         auto operator()(F x) const -> F { return x; }
     };
 
+    struct Relu {
+        template<std::floating_point F>
+        auto operator()(F x) const -> F { return std::max(x, F(0)); }
+    };
+
+    struct LeakyRelu {
+        static constexpr auto slope = 0.01f;
+
+        template<std::floating_point F>
+        auto operator()(F x) const -> F { return std::max(x, F(slope) * x); }
+    };
+
+    struct Tanh {
+        template<std::floating_point F>
+        auto operator()(F x) const -> F { return std::tanh(x); }
+    };
+
     inline static const auto linear = yam::activation(Linear());
     inline static const auto sigmoid = yam::activation(Sigmoid());
     inline static const auto bisigmoid = yam::activation(Bisigmoid());
+    inline static const auto relu = yam::activation(Relu());
+    inline static const auto leakyRelu = yam::activation(LeakyRelu());
+    inline static const auto tanh = yam::activation(Tanh());
+
+    static auto function(ActivationFunctionType type) -> activation_function {
+        switch (type) {
+            case ActivationFunctionType::Linear: return linear;
+            case ActivationFunctionType::Sigmoid: return sigmoid;
+            case ActivationFunctionType::Bisigmoid: return bisigmoid;
+            case ActivationFunctionType::Relu: return relu;
+            case ActivationFunctionType::LeakyRelu: return leakyRelu;
+            case ActivationFunctionType::Tanh: return tanh;
+            default: return {};
+        }
+    }
 };
 
+// derivations take already activated values, not the weighted sums
 struct Derivation {
     struct Sigmoid {
         template<std::floating_point F>
@@ -69,9 +106,42 @@ struct Derivation {
         auto operator()(F x) const -> F { return 1; }
     };
 
+    struct Relu {
+        template<std::floating_point F>
+        auto operator()(F x) const -> F { return F(x > 0); }
+    };
+
+    struct LeakyRelu {
+        template<std::floating_point F>
+        auto operator()(F x) const -> F {
+            constexpr auto slope = F(Activation::LeakyRelu::slope);
+            return slope + (1 - slope) * F(x > 0);
+        }
+    };
+
+    struct Tanh {
+        template<std::floating_point F>
+        auto operator()(F x) const -> F { return 1 - x * x; }
+    };
+
     inline static const auto linear = yam::activation(Linear());
     inline static const auto sigmoid = yam::activation(Sigmoid());
     inline static const auto bisigmoid = yam::activation(Bisigmoid());
+    inline static const auto relu = yam::activation(Relu());
+    inline static const auto leakyRelu = yam::activation(LeakyRelu());
+    inline static const auto tanh = yam::activation(Tanh());
+
+    static auto function(ActivationFunctionType type) -> derivation_function {
+        switch (type) {
+            case ActivationFunctionType::Linear: return linear;
+            case ActivationFunctionType::Sigmoid: return sigmoid;
+            case ActivationFunctionType::Bisigmoid: return bisigmoid;
+            case ActivationFunctionType::Relu: return relu;
+            case ActivationFunctionType::LeakyRelu: return leakyRelu;
+            case ActivationFunctionType::Tanh: return tanh;
+            default: return {};
+        }
+    }
 };
 
 }
\ No newline at end of file
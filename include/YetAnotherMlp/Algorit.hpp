@@ -31,7 +31,7 @@ struct Algorit {
         return *this;
     }
 
-    auto operator*() const -> Init { return init_; }
+    auto operator*() const -> const Init& { return init_; }
 
     auto operator->() const -> const Init* { return std::addressof(init_); }
     auto operator->()       ->       Init* { return std::addressof(init_); }
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+struct ConvolutionShape {
+    // of input images, channel after channel, rows of a channel after rows
+    int width;
+    int height;
+    int channels = 1;
+
+    // filters of kernel x kernel pixels of all channels, valid convolution
+    // with stride 1 followed by relu and pool x pool max pooling
+    int filters;
+    int kernel;
+    int pool = 2;
+};
+
+// Convolutional front end of a perceptron: its pooled feature maps, filter
+// after filter, are the inputs of the first dense layer. Images are unfolded
+// into columns (im2col), so that convolution and gradients of kernels are
+// plain products over contiguous rows.
+struct Convolution {
+    using Shape = ConvolutionShape;
+
+    Convolution(Shape shape) : shape_(shape) {
+        columns_.resize(patch() * outputs());
+        maps_.resize(shape_.filters * outputs());
+        pooled_.resize(outputSize());
+        maxima_.resize(outputSize());
+        kernels_.resize(shape_.filters * patch());
+        biases_.resize(shape_.filters);
+    }
+
+    auto shape() const -> const Shape& { return shape_; }
+
+    auto inputSize() const -> int { return shape_.width * shape_.height * shape_.channels; }
+
+    auto outputSize() const -> int {
+        return shape_.filters * (outputWidth() / shape_.pool) * (outputHeight() / shape_.pool);
+    }
+
+    // filter after filter, weights of a filter ordered as its patch
+    auto kernels() const -> std::span<const float> { return kernels_; }
+    auto kernels()       -> std::span<      float> { return kernels_; }
+
+    auto biases() const -> std::span<const float> { return biases_; }
+    auto biases()       -> std::span<      float> { return biases_; }
+
+    // pooled feature maps of input, valid until the next forward
+    auto forward(const float* input) -> std::span<const float> {
+        const auto [width, height, channels, filters, kernel, pool] = shape_;
+        const auto ow = outputWidth();
+        const auto oh = outputHeight();
+        const auto outputs = this->outputs();
+
+        // row (channel, ky, kx) holds the pixel under kernel's (ky, kx) for
+        // every output position
+        auto column = columns_.begin().base();
+        for (auto c = 0; c < channels; ++c) {
+            for (auto ky = 0; ky < kernel; ++ky) {
+                for (auto kx = 0; kx < kernel; ++kx) {
+                    for (auto oy = 0; oy < oh; ++oy) {
+                        column = std::copy_n(input + (c * height + oy + ky) * width + kx, ow, column);
+                    }
+                }
+            }
+        }
+
+        for (auto f = 0; f < filters; ++f) {
+            const auto map = maps_.begin().base() + f * outputs;
+            const auto weights = kernels_.begin().base() + f * patch();
+
+            std::fill_n(map, outputs, biases_[f]);
+            for (auto r = 0; r < patch(); ++r) {
+                Simd::axpy(weights[r], columns_.begin().base() + r * outputs, map, outputs);
+            }
+
+            for (auto o = 0; o < outputs; ++o) {
+                map[o] = std::max(map[o], 0.0f);
+            }
+        }
+
+        // maxima_ remembers which position of a window won
+        const auto pw = ow / pool;
+        const auto ph = oh / pool;
+        for (auto f = 0; f < filters; ++f) {
+            for (auto py = 0; py < ph; ++py) {
+                for (auto px = 0; px < pw; ++px) {
+                    const auto p = (f * ph + py) * pw + px;
+                    auto best = f * outputs + py * pool * ow + px * pool;
+
+                    for (auto dy = 0; dy < pool; ++dy) {
+                        for (auto dx = 0; dx < pool; ++dx) {
+                            const auto o = f * outputs + (py * pool + dy) * ow + px * pool + dx;
+                            best = maps_[o] > maps_[best] ? o : best;
+                        }
+                    }
+
+                    pooled_[p] = maps_[best];
+                    maxima_[p] = best;
+                }
+            }
+        }
+
+        return pooled_;
+    }
+
+    // pooled feature maps of the last forward
+    auto output() const -> std::span<const float> { return pooled_; }
+
+    // corrects kernels and biases by error of the pooled outputs of the
+    // last forward, as the trainer corrects dense layers
+    auto backward(const float* error, float learnrate) -> void {
+        const auto filters = shape_.filters;
+        const auto outputs = this->outputs();
+
+        // errors reach the winners of pooling windows through relu
+        std::ranges::fill(maps_, 0.0f);
+        for (auto p = 0u; p < pooled_.size(); ++p) {
+            maps_[maxima_[p]] = pooled_[p] > 0.0f ? error[p] : 0.0f;
+        }
+
+        for (auto f = 0; f < filters; ++f) {
+            const auto map = maps_.begin().base() + f * outputs;
+            const auto weights = kernels_.begin().base() + f * patch();
+
+            for (auto r = 0; r < patch(); ++r) {
+                weights[r] += learnrate * Simd::dot(map, columns_.begin().base() + r * outputs, outputs);
+            }
+
+            auto sum = 0.0f;
+            for (auto o = 0; o < outputs; ++o) {
+                sum += map[o];
+            }
+            biases_[f] += learnrate * sum;
+        }
+    }
+
+private:
+    auto outputWidth() const -> int { return shape_.width - shape_.kernel + 1; }
+    auto outputHeight() const -> int { return shape_.height - shape_.kernel + 1; }
+    auto outputs() const -> int { return outputWidth() * outputHeight(); }
+    auto patch() const -> int { return shape_.channels * shape_.kernel * shape_.kernel; }
+
+    Shape shape_;
+    std::vector<float> columns_;
+    std::vector<float> maps_;
+    std::vector<float> pooled_;
+    std::vector<int> maxima_;
+    std::vector<float> kernels_;
+    std::vector<float> biases_;
+};
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -23,13 +25,46 @@ public:
         std::vector<float> inputs,
         std::vector<float> outputs,
         int size
-    ) : inputs_(std::move(inputs)),
-        outputs_(std::move(outputs)),
+    ) : ownedInputs_(std::move(inputs)),
+        ownedOutputs_(std::move(outputs)),
+        inputs_(ownedInputs_),
+        outputs_(ownedOutputs_),
         size_(size)
     {
 
     }
 
+    // samples in memory kept alive by storage, e.g. a mapped cache file;
+    // copies of the dataset share them instead of copying
+    Dataset(
+        std::span<float> inputs,
+        std::span<float> outputs,
+        int size,
+        std::shared_ptr<void> storage
+    ) : storage_(std::move(storage)),
+        inputs_(inputs),
+        outputs_(outputs),
+        size_(size)
+    {
+
+    }
+
+    Dataset(const Dataset& dataset)
+      : ownedInputs_(dataset.ownedInputs_),
+        ownedOutputs_(dataset.ownedOutputs_),
+        storage_(dataset.storage_),
+        inputs_(storage_ ? dataset.inputs_ : ownedInputs_),
+        outputs_(storage_ ? dataset.outputs_ : ownedOutputs_),
+        size_(dataset.size_)
+    {
+
+    }
+
+    // moved vectors keep their buffers, so views stay valid
+    Dataset(Dataset&&) = default;
+    auto operator=(Dataset&&) -> Dataset& = default;
+    auto operator=(const Dataset& dataset) -> Dataset& { return *this = Dataset(dataset); }
+
     auto size() const -> int { return size_; }
     auto inputSize() const -> int { return size() ? input(0).size() : 0; }
     auto outputSize() const -> int { return size() ? output(0).size() : 0; }
@@ -39,9 +74,85 @@ public:
     auto output(int i) const -> std::span<const float> { return batch(outputs_, i); }
     auto output(int i)       -> std::span<      float> { return batch(outputs_, i); }
 
+    // all samples, one after another
+    auto inputs () const -> std::span<const float> { return inputs_; }
+    auto outputs() const -> std::span<const float> { return outputs_; }
+
+    // whether samples live in shared storage instead of the dataset
+    auto external() const -> bool { return storage_ != nullptr; }
+
+    // copies samples in given order into consecutive samples of into,
+    // so that later passes over into read memory sequentially
+    auto gather(std::span<const int> indexes, Dataset& into) const -> void {
+        gather(indexes, into, [](int, std::span<float>) {});
+    }
+
+    // transform(k, input) is called on every copied input while it is still
+    // in cache, e.g. to normalize or augment the staged copy in place
+    template<typename Transform>
+    auto gather(std::span<const int> indexes, Dataset& into, Transform&& transform) const -> void {
+        shape(indexes.size(), into);
+        gather(indexes, into, 0, indexes.size(), transform);
+    }
+
+    // resizes into to hold samples of this dataset, keeps it when it fits
+    // and owns its samples
+    auto shape(int samples, Dataset& into) const -> void {
+        const auto in = inputSize();
+        const auto out = outputSize();
+
+        if (into.external() || into.size() != samples || into.inputSize() != in || into.outputSize() != out) {
+            into = Dataset(
+                std::vector<float>(samples * in),
+                std::vector<float>(samples * out),
+                samples
+            );
+        }
+    }
+
+    // samples [first, last) of the order only, into has to be shaped already,
+    // so that threads can gather disjoint ranges
+    template<typename Transform>
+    auto gather(
+        std::span<const int> indexes,
+        Dataset& into,
+        int first,
+        int last,
+        Transform&& transform
+    ) const -> void {
+        for (auto k = first; k < last; ++k) {
+            if (k + prefetchDistance < last) {
+                prefetch(indexes[k + prefetchDistance]);
+            }
+
+            const auto input = into.input(k);
+            std::ranges::copy(this->input(indexes[k]), input.begin());
+            std::ranges::copy(this->output(indexes[k]), into.output(k).begin());
+            transform(k, input);
+        }
+    }
+
 private:
-    std::vector<float> inputs_;
-    std::vector<float> outputs_;
+    static constexpr auto prefetchDistance = 4;
+
+    auto prefetch(int i) const -> void {
+#if defined(__GNUC__)
+        const auto input = this->input(i);
+        const auto first = reinterpret_cast<const char*>(input.data());
+        const auto last = reinterpret_cast<const char*>(input.data() + input.size());
+
+        for (auto line = first; line < last; line += 64) {
+            __builtin_prefetch(line);
+        }
+        __builtin_prefetch(this->output(i).data());
+#endif
+    }
+
+    std::vector<float> ownedInputs_;
+    std::vector<float> ownedOutputs_;
+    std::shared_ptr<void> storage_;
+    std::span<float> inputs_;
+    std::span<float> outputs_;
     int size_;
 };
 
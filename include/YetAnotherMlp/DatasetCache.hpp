@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Dataset.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yam {
+
+// Datasets in a binary file that is mapped back without parsing: a header
+// of magic, shape and checksum, then inputs and outputs as host floats, both
+// aligned to cache lines. Samples are cached as they are, e.g. already
+// normalized, and loaded datasets are private copy-on-write mappings of the
+// file.
+struct DatasetCache {
+
+static constexpr auto magicNumber = std::uint32_t(0x31646179); // "yad1"
+static constexpr auto alignment = std::size_t(64);
+
+struct Header {
+    std::uint32_t magic;
+    std::uint32_t inputSize;
+    std::uint32_t outputSize;
+    std::uint32_t samples;
+    std::uint64_t checksum;
+};
+
+static auto save(
+    const Dataset& dataset,
+    const char* filename
+) -> bool {
+    const auto header = Header {
+        .magic = magicNumber,
+        .inputSize = static_cast<std::uint32_t>(dataset.inputSize()),
+        .outputSize = static_cast<std::uint32_t>(dataset.outputSize()),
+        .samples = static_cast<std::uint32_t>(dataset.size()),
+        .checksum = checksum(dataset.outputs(), checksum(dataset.inputs()))
+    };
+
+    auto file = std::ofstream(filename, std::ios::binary);
+    const auto write = [&file](const void* data, std::size_t size) {
+        file.write(static_cast<const char*>(data), size);
+
+        const auto zeros = std::array<char, alignment>();
+        file.write(zeros.data(), padded(size) - size);
+    };
+
+    write(&header, sizeof(header));
+    write(dataset.inputs().data(), dataset.inputs().size_bytes());
+    write(dataset.outputs().data(), dataset.outputs().size_bytes());
+    return file.good();
+}
+
+// dataset mapped from filename, nullopt when the file is missing, is not a
+// complete cache or, with verify, does not match its checksum
+static auto load(
+    const char* filename,
+    bool verify = true
+) -> std::optional<Dataset> {
+    const auto descriptor = ::open(filename, O_RDONLY);
+    if (descriptor < 0) {
+        return std::nullopt;
+    }
+
+    struct stat status;
+    const auto size = ::fstat(descriptor, &status) == 0 ? static_cast<std::size_t>(status.st_size) : 0;
+    const auto address = size >= sizeof(Header)
+        ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0)
+        : MAP_FAILED;
+    ::close(descriptor);
+
+    if (address == MAP_FAILED) {
+        return std::nullopt;
+    }
+
+    const auto storage = std::shared_ptr<void>(address, [size](void* address) { ::munmap(address, size); });
+    const auto bytes = static_cast<std::byte*>(address);
+
+    auto header = Header();
+    std::memcpy(&header, bytes, sizeof(header));
+
+    const auto inputs = std::size_t(header.samples) * header.inputSize;
+    const auto outputs = std::size_t(header.samples) * header.outputSize;
+    const auto inputsOffset = padded(sizeof(Header));
+    const auto outputsOffset = inputsOffset + padded(inputs * sizeof(float));
+
+    if (header.magic != magicNumber || header.samples == 0
+        || size != outputsOffset + padded(outputs * sizeof(float))
+    ) {
+        return std::nullopt;
+    }
+
+    auto dataset = Dataset(
+        std::span(reinterpret_cast<float*>(bytes + inputsOffset), inputs),
+        std::span(reinterpret_cast<float*>(bytes + outputsOffset), outputs),
+        header.samples,
+        storage
+    );
+
+    if (verify && checksum(dataset.outputs(), checksum(dataset.inputs())) != header.checksum) {
+        return std::nullopt;
+    }
+    return dataset;
+}
+
+// dataset of the cache file, read() builds and caches it when the file is
+// missing or broken; caches of changed sources have to be removed by hand
+template<typename Read>
+static auto cached(
+    const char* filename,
+    Read&& read
+) -> Dataset {
+    if (auto dataset = load(filename)) {
+        return std::move(*dataset);
+    }
+
+    auto dataset = read();
+    if (dataset.size() > 0) {
+        save(dataset, filename);
+    }
+    return dataset;
+}
+
+// FNV-1a over 32 bit words in four interleaved lanes, so that verification
+// is not bound by the latency of a single multiplication chain
+static auto checksum(
+    std::span<const float> values,
+    std::uint64_t hash = 0xcbf29ce484222325
+) -> std::uint64_t {
+    constexpr auto prime = std::uint64_t(0x100000001b3);
+
+    auto lanes = std::array { hash, hash ^ 1, hash ^ 2, hash ^ 3 };
+    auto i = std::size_t(0);
+    for (; i + 4 <= values.size(); i += 4) {
+        for (auto l = 0; l < 4; ++l) {
+            lanes[l] = (lanes[l] ^ std::bit_cast<std::uint32_t>(values[i + l])) * prime;
+        }
+    }
+    for (; i < values.size(); ++i) {
+        lanes[0] = (lanes[0] ^ std::bit_cast<std::uint32_t>(values[i])) * prime;
+    }
+
+    for (const auto lane : lanes | std::views::drop(1)) {
+        lanes[0] = (lanes[0] ^ lane) * prime;
+    }
+    return (lanes[0] ^ values.size()) * prime;
+}
+
+private:
+
+static constexpr auto padded(std::size_t size) -> std::size_t {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+};
+
+}
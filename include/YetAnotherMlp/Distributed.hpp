@@ -0,0 +1,381 @@
+#pragma once
+
+#include "Dataset.hpp"
+#include "MLPerceptron.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace yam {
+
+// Processes connected in a ring over TCP on localhost, rank r listens on
+// port + r and connects to its right neighbour. Collectives are blocking
+// and have to be called by every rank in the same order.
+struct Ring {
+    Ring(
+        int rank,
+        int size,
+        std::uint16_t port,
+        std::chrono::milliseconds timeout = std::chrono::seconds(30)
+    ) : rank_(rank), size_(size)
+    {
+        if (size_ > 1) {
+            valid_ = connect(port, timeout);
+        }
+    }
+
+    Ring(const Ring&) = delete;
+    auto operator=(const Ring&) -> Ring& = delete;
+
+    ~Ring() {
+        for (const auto socket : {left_, right_}) {
+            if (socket >= 0) {
+                ::close(socket);
+            }
+        }
+    }
+
+    auto rank() const -> int { return rank_; }
+    auto size() const -> int { return size_; }
+    auto valid() const -> bool { return valid_; }
+
+    // sums values of all ranks in place: reduce-scatter followed by all-gather,
+    // every rank sends and receives 2 * (size - 1) / size of values
+    auto allReduce(std::span<float> values) -> bool {
+        if (size_ == 1) {
+            return true;
+        }
+        if (!valid_) {
+            return false;
+        }
+
+        const auto chunk = [&](int c) {
+            c = (c % size_ + size_) % size_;
+            const auto length = (values.size() + size_ - 1) / size_;
+            const auto first = std::min(values.size(), c * length);
+            return values.subspan(first, std::min(length, values.size() - first));
+        };
+
+        received_.resize((values.size() + size_ - 1) / size_);
+
+        for (auto step = 0; step < size_ - 1; ++step) {
+            const auto send = chunk(rank_ - step);
+            const auto recv = chunk(rank_ - step - 1);
+
+            if (!exchange(send, std::span(received_).first(recv.size()))) {
+                return valid_ = false;
+            }
+
+            std::ranges::transform(recv, received_, recv.begin(), std::plus<>{});
+        }
+
+        for (auto step = 0; step < size_ - 1; ++step) {
+            const auto send = chunk(rank_ - step + 1);
+            const auto recv = chunk(rank_ - step);
+
+            if (!exchange(send, recv)) {
+                return valid_ = false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    auto connect(std::uint16_t port, std::chrono::milliseconds timeout) -> bool {
+        const auto listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listener < 0) {
+            return false;
+        }
+
+        const auto enable = 1;
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        const auto own = address(port + rank_);
+        const auto listening = ::bind(listener, reinterpret_cast<const sockaddr*>(&own), sizeof(own)) == 0
+            && ::listen(listener, 1) == 0;
+
+        if (listening) {
+            const auto right = address(port + (rank_ + 1) % size_);
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+            while (right_ < 0 && std::chrono::steady_clock::now() < deadline) {
+                right_ = ::socket(AF_INET, SOCK_STREAM, 0);
+                if (::connect(right_, reinterpret_cast<const sockaddr*>(&right), sizeof(right)) != 0) {
+                    ::close(right_);
+                    right_ = -1;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+
+            if (right_ >= 0) {
+                left_ = ::accept(listener, nullptr, nullptr);
+            }
+        }
+
+        ::close(listener);
+
+        for (const auto socket : {left_, right_}) {
+            if (socket < 0) {
+                return false;
+            }
+            ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            ::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) | O_NONBLOCK);
+        }
+
+        return true;
+    }
+
+    static auto address(int port) -> sockaddr_in {
+        auto address = sockaddr_in();
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+
+    // sends to the right and receives from the left at the same time,
+    // so that ranks blocked on full socket buffers cannot deadlock
+    auto exchange(std::span<const float> send, std::span<float> recv) -> bool {
+        auto out = std::as_bytes(send);
+        auto in = std::as_writable_bytes(recv);
+
+        while (!out.empty() || !in.empty()) {
+            auto fds = std::array {
+                pollfd { .fd = right_, .events = short(out.empty() ? 0 : POLLOUT) },
+                pollfd { .fd = left_, .events = short(in.empty() ? 0 : POLLIN) }
+            };
+
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                return false;
+            }
+
+            if (fds[0].revents & (POLLERR | POLLHUP) || fds[1].revents & POLLERR) {
+                return false;
+            }
+
+            if (fds[0].revents & POLLOUT) {
+                const auto sent = ::send(right_, out.data(), out.size(), MSG_NOSIGNAL);
+                if (sent < 0 && errno != EAGAIN) {
+                    return false;
+                }
+                out = out.subspan(std::max<ssize_t>(sent, 0));
+            }
+
+            if (fds[1].revents & (POLLIN | POLLHUP)) {
+                const auto read = ::recv(left_, in.data(), in.size(), 0);
+                if (read == 0 || (read < 0 && errno != EAGAIN)) {
+                    return false;
+                }
+                in = in.subspan(std::max<ssize_t>(read, 0));
+            }
+        }
+
+        return true;
+    }
+
+    int rank_;
+    int size_;
+    int left_ = -1;
+    int right_ = -1;
+    bool valid_ = true;
+    std::vector<float> received_;
+};
+
+// rank's part of dataset, all ranks get the same number of samples
+inline auto shard(const Dataset& dataset, int rank, int size) -> Dataset {
+    const auto samples = dataset.size() / size;
+    const auto first = rank * samples;
+
+    auto inputs = std::vector<float>();
+    auto outputs = std::vector<float>();
+    inputs.reserve(samples * dataset.inputSize());
+    outputs.reserve(samples * dataset.outputSize());
+
+    for (auto i = first; i < first + samples; ++i) {
+        std::ranges::copy(dataset.input(i), std::back_inserter(inputs));
+        std::ranges::copy(dataset.output(i), std::back_inserter(outputs));
+    }
+
+    return Dataset(std::move(inputs), std::move(outputs), samples);
+}
+
+// Data parallel synchronization for TrainerOptions::synchronize. Every rank
+// trains its shard and periodically sums weight deltas (accumulated gradient
+// steps) with the ring, the consensus model moves by their average.
+//
+// With overlap the reduction runs on a communication thread while the next
+// period trains: a rank keeps its own unreduced progress on top of the
+// consensus and folds the reduced deltas in one period later. Buckets are
+// reduced layer by layer from the top, the order backpropagation produces
+// them. A flush, e.g. at the end of an epoch, is synchronous and leaves the
+// same model on every rank.
+struct DataParallel {
+    DataParallel(
+        Ring& ring,
+        bool overlap = true
+    ) : ring_(std::addressof(ring)),
+        overlap_(overlap),
+        communicator_([this] { communicate(); })
+    {
+
+    }
+
+    DataParallel(const DataParallel&) = delete;
+    auto operator=(const DataParallel&) -> DataParallel& = delete;
+
+    ~DataParallel() {
+        {
+            const auto lock = std::lock_guard(mutex_);
+            stop_ = true;
+        }
+        changed_.notify_all();
+        communicator_.join();
+    }
+
+    auto operator()(MLPerceptron& trainee, bool flush) -> void {
+        if (base_.empty()) {
+            start(trainee);
+            return;
+        }
+
+        wait();
+
+        auto weights = trainee.weights();
+        auto biases = trainee.biases();
+
+        // local progress since the last synchronization
+        for (auto i = 0u; i < weights.size(); ++i) {
+            delta_[i] = weights[i] - anchor_[i];
+        }
+        for (auto i = 0u; i < biases.size(); ++i) {
+            delta_[weights.size() + i] = biases[i] - anchor_[weights.size() + i];
+        }
+
+        if (flush || !overlap_) {
+            reduce();
+            apply(weights, biases, false);
+        } else {
+            apply(weights, biases, true);
+            post();
+        }
+    }
+
+    auto valid() const -> bool { return valid_; }
+
+private:
+    // the same starting point for every rank: average of initial models
+    auto start(MLPerceptron& trainee) -> void {
+        base_.assign(trainee.weights().begin(), trainee.weights().end());
+        base_.insert(base_.end(), trainee.biases().begin(), trainee.biases().end());
+        delta_.resize(base_.size());
+        reduced_.resize(base_.size());
+
+        for (auto offset = 0; const auto [lc, uc] : std::views::adjacent<2>(trainee.topology())) {
+            buckets_.emplace_back(offset, lc * uc);
+            offset += lc * uc;
+        }
+        if (!trainee.biases().empty()) {
+            for (auto offset = int(trainee.weights().size()); const auto uc : trainee.topology() | std::views::drop(1)) {
+                buckets_.emplace_back(offset, uc);
+                offset += uc;
+            }
+        }
+        std::ranges::sort(buckets_, std::greater<>{});
+
+        valid_ = ring_->allReduce(base_) && valid_;
+        for (auto& value : base_) {
+            value /= ring_->size();
+        }
+
+        std::ranges::copy(std::span(base_).first(trainee.weights().size()), trainee.weights().begin());
+        std::ranges::copy(std::span(base_).last(trainee.biases().size()), trainee.biases().begin());
+        anchor_ = base_;
+    }
+
+    // moves consensus by the average of reduced deltas and puts the model on it,
+    // own unreduced delta stays on top when it is still to be reduced
+    auto apply(std::span<float> weights, std::span<float> biases, bool keepDelta) -> void {
+        for (auto i = 0u; i < base_.size(); ++i) {
+            base_[i] += reduced_[i] / ring_->size();
+            anchor_[i] = base_[i] + (keepDelta ? delta_[i] : 0.0f);
+        }
+        std::ranges::fill(reduced_, 0.0f);
+
+        std::ranges::copy(std::span(anchor_).first(weights.size()), weights.begin());
+        std::ranges::copy(std::span(anchor_).last(biases.size()), biases.begin());
+    }
+
+    auto reduce() -> void {
+        reduced_ = delta_;
+        for (const auto [offset, size] : buckets_) {
+            valid_ = ring_->allReduce(std::span(reduced_).subspan(offset, size)) && valid_;
+        }
+    }
+
+    auto post() -> void {
+        {
+            const auto lock = std::lock_guard(mutex_);
+            pending_ = true;
+        }
+        changed_.notify_all();
+    }
+
+    auto wait() -> void {
+        auto lock = std::unique_lock(mutex_);
+        changed_.wait(lock, [this] { return !pending_; });
+    }
+
+    auto communicate() -> void {
+        while (true) {
+            auto lock = std::unique_lock(mutex_);
+            changed_.wait(lock, [this] { return stop_ || pending_; });
+            if (stop_) {
+                return;
+            }
+            lock.unlock();
+
+            reduce();
+
+            lock.lock();
+            pending_ = false;
+            changed_.notify_all();
+        }
+    }
+
+    Ring* ring_;
+    bool overlap_;
+    bool valid_ = true;
+
+    std::vector<float> base_;
+    std::vector<float> anchor_;
+    std::vector<float> delta_;
+    std::vector<float> reduced_;
+    std::vector<std::pair<int, int>> buckets_;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    bool pending_ = false;
+    bool stop_ = false;
+    std::thread communicator_;
+};
+
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "Activation.hpp"
+#include "Dataset.hpp"
+#include "MLPerceptron.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+// Trains K perceptrons of the same topology in lockstep, e.g. for a sweep over
+// seeds and learnrates. Parameters are interleaved by model (weight w of model
+// k is at w * K + k), so every sample is read once for all models and the
+// innermost loops run over models, contiguous and vectorizable.
+struct EnsembleTrainer {
+    EnsembleTrainer(
+        const MLPerceptron& prototype,
+        std::vector<float> learnrates,
+        std::vector<std::uint32_t> seeds,
+        const Dataset& trainset,
+        const Dataset& testset
+    ) : topology_(prototype.topology().begin(), prototype.topology().end()),
+        models_(learnrates.size()),
+        learnrates_(std::move(learnrates)),
+        weights_(prototype.weights().size() * models_),
+        biases_(prototype.biases().size() * models_),
+        neurons_(prototype.neurons().size() * models_),
+        errors_(neurons_.size()),
+        derived_(neurons_.size()),
+        testErrors_(models_),
+        trainset_(trainset),
+        testset_(testset),
+        indexes_(trainset.size()),
+        random_(seeds.empty() ? 0 : seeds.front())
+    {
+        for (auto l = 0; l < topology_.size() - 1; ++l) {
+            activationTypes_.push_back(prototype.activations()[l]);
+            activations_.push_back(prototype.activation(l));
+            derivations_.push_back(Derivation::function(activationTypes_.back()));
+        }
+
+        for (auto k = 0; k < models_; ++k) {
+            auto random = Random(seeds[k]);
+            for (auto w = 0u; w < prototype.weights().size(); ++w) {
+                weights_[w * models_ + k] = random.separated(0.3f, 0.2f);
+            }
+            for (auto b = 0u; b < prototype.biases().size(); ++b) {
+                biases_[b * models_ + k] = random.separated(0.3f, 0.2f);
+            }
+        }
+
+        std::ranges::copy(std::views::iota(0, trainset.size()), indexes_.begin());
+    }
+
+    auto size() const -> int { return models_; }
+
+    // trains one epoch of all models, returns their testset errors
+    auto epoch() -> std::span<const float> {
+        random_.shuffle(indexes_);
+        trainset_.gather(indexes_, staged_);
+
+        for (auto i = 0; i < staged_.size(); ++i) {
+            backpropagate(staged_.input(i).data(), staged_.output(i).data());
+        }
+
+        return evaluate();
+    }
+
+    // mean squared distances of every model on testset
+    auto evaluate() -> std::span<const float> {
+        std::ranges::fill(testErrors_, 0.0f);
+
+        const auto outputs = topology_.back() * models_;
+        for (auto i = 0; i < testset_.size(); ++i) {
+            const auto actual = forward(testset_.input(i).data());
+            const auto expected = testset_.output(i);
+
+            for (auto o = 0; o < outputs; ++o) {
+                const auto diff = expected[o / models_] - actual[o];
+                testErrors_[o % models_] += diff * diff;
+            }
+        }
+
+        for (auto& error : testErrors_) {
+            error /= std::max(testset_.size(), 1);
+        }
+
+        return testErrors_;
+    }
+
+    // outputs of all models, interleaved by model
+    auto forward(const float* input) -> std::span<const float> {
+        gather(input);
+
+        auto lower = input;
+        auto upper = neurons_.data();
+        auto weight = weights_.data();
+        auto bias = biases_.empty() ? nullptr : biases_.data();
+
+        for (auto l = 0; l < topology_.size() - 1; ++l) {
+            const auto lc = topology_[l];
+            const auto uc = topology_[l + 1];
+
+            if (bias) {
+                std::copy_n(bias, uc * models_, upper);
+            } else {
+                std::fill_n(upper, uc * models_, 0.0f);
+            }
+
+            for (auto u = 0; u < uc; ++u) {
+                const auto sum = upper + u * models_;
+
+                const auto row = weight + u * lc * models_;
+                if (l == 0) {
+                    for (const auto i : nonzeros_) {
+                        const auto w = row + i * models_;
+                        const auto x = input[i];
+                        for (auto k = 0; k < models_; ++k) {
+                            sum[k] += w[k] * x;
+                        }
+                    }
+                } else {
+                    for (auto i = 0; i < lc; ++i) {
+                        const auto w = row + i * models_;
+                        const auto x = lower + i * models_;
+                        for (auto k = 0; k < models_; ++k) {
+                            sum[k] += w[k] * x[k];
+                        }
+                    }
+                }
+            }
+
+            activations_[l]({upper, upper + uc * models_}, upper);
+
+            weight += lc * uc * models_;
+            bias += bias ? uc * models_ : 0;
+            lower = upper;
+            upper += uc * models_;
+        }
+
+        return {lower, upper};
+    }
+
+    // de-interleaved copy of k-th model
+    auto model(int k) const -> MLPerceptron {
+        auto mlp = MLPerceptron(topology_, !biases_.empty(), std::vector(activationTypes_));
+        for (auto w = 0u; w < mlp.weights().size(); ++w) {
+            mlp.weights()[w] = weights_[w * models_ + k];
+        }
+        for (auto b = 0u; b < mlp.biases().size(); ++b) {
+            mlp.biases()[b] = biases_[b * models_ + k];
+        }
+        return mlp;
+    }
+
+private:
+    auto gather(const float* input) -> void {
+        nonzeros_.clear();
+        for (auto i = 0; i < topology_.front(); ++i) {
+            if (input[i] != 0) {
+                nonzeros_.push_back(i);
+            }
+        }
+    }
+
+    auto backpropagate(const float* input, const float* expected) -> void {
+        const auto actual = forward(input);
+        const auto layers = static_cast<int>(topology_.size()) - 1;
+
+        auto derived = derived_.data();
+        auto signal = neurons_.data();
+        for (auto l = 0; l < layers; ++l) {
+            const auto size = topology_[l + 1] * models_;
+            derived = derivations_[l]({signal, signal + size}, derived);
+            signal += size;
+        }
+
+        // offsets of layers' neurons, weights and biases, walked from the top
+        auto neuron = static_cast<std::ptrdiff_t>(neurons_.size());
+        auto weight = static_cast<std::ptrdiff_t>(weights_.size());
+        auto bias = static_cast<std::ptrdiff_t>(biases_.size());
+
+        const auto outputs = topology_.back() * models_;
+        neuron -= outputs;
+        for (auto o = 0; o < outputs; ++o) {
+            errors_[neuron + o] = derived_[neuron + o] * (expected[o / models_] - actual[o]);
+        }
+
+        for (auto l = layers - 1; l >= 0; --l) {
+            const auto lc = topology_[l];
+            const auto uc = topology_[l + 1];
+            const auto upper = neuron;
+
+            weight -= lc * uc * models_;
+            bias -= biases_.empty() ? 0 : uc * models_;
+
+            if (l > 0) {
+                neuron -= lc * models_;
+                hiddenLayerError(errors_.data() + neuron, derived_.data() + neuron,
+                    weights_.data() + weight, errors_.data() + upper, lc, uc);
+                correct(errors_.data() + upper, weights_.data() + weight,
+                    neurons_.data() + neuron, lc, uc);
+            } else {
+                correctInput(errors_.data() + upper, weights_.data() + weight, input, lc, uc);
+            }
+
+            if (!biases_.empty()) {
+                const auto b = biases_.data() + bias;
+                const auto e = errors_.data() + upper;
+                for (auto u = 0; u < uc * models_; ++u) {
+                    b[u] += learnrates_[u % models_] * e[u];
+                }
+            }
+        }
+    }
+
+    auto hiddenLayerError(
+              float* error,
+        const float* derived,
+        const float* weight,
+        const float* upper,
+        int lc,
+        int uc
+    ) const -> void {
+        std::fill_n(error, lc * models_, 0.0f);
+
+        for (auto u = 0; u < uc; ++u) {
+            const auto e = upper + u * models_;
+            for (auto l = 0; l < lc; ++l) {
+                const auto w = weight + (u * lc + l) * models_;
+                const auto sum = error + l * models_;
+                for (auto k = 0; k < models_; ++k) {
+                    sum[k] += w[k] * e[k];
+                }
+            }
+        }
+
+        for (auto n = 0; n < lc * models_; ++n) {
+            error[n] *= derived[n];
+        }
+    }
+
+    auto correct(
+        const float* error,
+              float* weight,
+        const float* signal,
+        int lc,
+        int uc
+    ) -> void {
+        for (auto u = 0; u < uc; ++u) {
+            scaled(error + u * models_);
+            for (auto l = 0; l < lc; ++l) {
+                const auto w = weight + (u * lc + l) * models_;
+                const auto s = signal + l * models_;
+                for (auto k = 0; k < models_; ++k) {
+                    w[k] += delta_[k] * s[k];
+                }
+            }
+        }
+    }
+
+    // input is shared by all models, zero inputs do not change weights
+    auto correctInput(
+        const float* error,
+              float* weight,
+        const float* input,
+        int lc,
+        int uc
+    ) -> void {
+        for (auto u = 0; u < uc; ++u) {
+            scaled(error + u * models_);
+            for (const auto l : nonzeros_) {
+                const auto w = weight + (u * lc + l) * models_;
+                const auto s = input[l];
+                for (auto k = 0; k < models_; ++k) {
+                    w[k] += delta_[k] * s;
+                }
+            }
+        }
+    }
+
+    auto scaled(const float* error) -> void {
+        delta_.resize(models_);
+        for (auto k = 0; k < models_; ++k) {
+            delta_[k] = learnrates_[k] * error[k];
+        }
+    }
+
+    std::vector<int> topology_;
+    int models_;
+    std::vector<float> learnrates_;
+
+    std::vector<float> weights_;
+    std::vector<float> biases_;
+    std::vector<float> neurons_;
+    std::vector<float> errors_;
+    std::vector<float> derived_;
+    std::vector<float> delta_;
+    std::vector<float> testErrors_;
+    std::vector<int> nonzeros_;
+
+    std::vector<activation_function> activations_;
+    std::vector<derivation_function> derivations_;
+    std::vector<ActivationFunctionType> activationTypes_;
+
+    Dataset trainset_;
+    Dataset testset_;
+    Dataset staged_;
+    std::vector<int> indexes_;
+    Random random_;
+};
+
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Dataset.hpp"
+#include "MLPerceptron.hpp"
+#include "Mathematics.hpp"
+#include "ThreadPool.hpp"
+#include "Transform.hpp"
+
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace yam {
+
+enum class Metric {
+    Error,    // mean squared distance, lower is better
+    Accuracy, // fraction of samples with the expected class on top
+    TopK      // fraction of samples with the expected class among k best
+};
+
+// Metrics of a perceptron on a dataset. Class of a sample is its largest
+// output, single output networks have classes 0 and 1 split at 0.5.
+struct Evaluation {
+    int samples = 0;
+    int classes = 0;
+    int k = 1;
+    int correct = 0;
+    int correctTopK = 0;
+    float distance = 0.0f;
+
+    // row of expected class, column of predicted class
+    std::vector<int> confusion;
+
+    auto error() const -> float { return distance / std::max(samples, 1); }
+    auto accuracy() const -> float { return float(correct) / std::max(samples, 1); }
+    auto topKAccuracy() const -> float { return float(correctTopK) / std::max(samples, 1); }
+
+    auto metric(Metric metric) const -> float {
+        switch (metric) {
+            case Metric::Accuracy: return accuracy();
+            case Metric::TopK: return topKAccuracy();
+            default: return error();
+        }
+    }
+
+    auto count(int expected, int predicted) const -> int {
+        return confusion[expected * classes + predicted];
+    }
+
+    auto add(std::span<const float> expected, std::span<const float> actual) -> void {
+        const auto wanted = label(expected);
+        const auto predicted = label(actual);
+
+        // outputs beating the expected class' one, ties count for it
+        const auto better = classes == 2 && actual.size() == 1
+            ? int(wanted != predicted)
+            : static_cast<int>(std::ranges::count_if(actual, [&](float a) { return a > actual[wanted]; }));
+
+        samples += 1;
+        correct += wanted == predicted;
+        correctTopK += better < k;
+        distance += Simd::distance(expected.data(), actual.data(), expected.size());
+        confusion[wanted * classes + predicted] += 1;
+    }
+
+    // merges metrics of consecutive parts of a dataset
+    auto operator+=(const Evaluation& other) -> Evaluation& {
+        samples += other.samples;
+        correct += other.correct;
+        correctTopK += other.correctTopK;
+        distance += other.distance;
+        std::ranges::transform(confusion, other.confusion, confusion.begin(), std::plus<>{});
+        return *this;
+    }
+
+    // zeroes metrics keeping the confusion matrix' storage when its size fits
+    auto reset(int outputs, int k) -> void {
+        classes = outputs == 1 ? 2 : outputs;
+        this->k = k;
+        samples = correct = correctTopK = 0;
+        distance = 0.0f;
+        confusion.assign(classes * classes, 0);
+    }
+
+    static auto empty(int outputs, int k) -> Evaluation {
+        auto evaluation = Evaluation();
+        evaluation.reset(outputs, k);
+        return evaluation;
+    }
+
+private:
+    static auto label(std::span<const float> outputs) -> int {
+        if (outputs.size() == 1) {
+            return outputs[0] >= 0.5f;
+        }
+        return std::ranges::max_element(outputs) - outputs.begin();
+    }
+};
+
+struct EvaluationOptions {
+    int k = 5;
+
+    // chunks are evaluated by the pool's workers on their own copies
+    ThreadPool* pool = nullptr;
+
+    // non-augmenting stages are applied to inputs first
+    const Transforms* transforms = nullptr;
+};
+
+// Every metric from a single forward of each sample into an evaluation,
+// whose storage is reused. Chunks are merged in order, so that results do
+// not depend on the number of threads. Without a pool nothing is allocated
+// once the evaluation and the thread's transform scratch have their sizes.
+inline auto evaluate(
+    const Dataset& dataset,
+    MLPerceptron& mlp,
+    Evaluation& into,
+    EvaluationOptions options = {}
+) -> void {
+    static constexpr auto grain = 64;
+
+    const auto transform = options.transforms && options.transforms->evaluated();
+
+    const auto add = [&](Evaluation& evaluation, MLPerceptron& mlp, int first, int last) {
+        thread_local auto transformed = std::vector<float>();
+        if (transform) {
+            transformed.resize(dataset.inputSize());
+        }
+
+        for (auto i = first; i < last; ++i) {
+            auto input = dataset.input(i).begin().base();
+            if (transform) {
+                std::ranges::copy(dataset.input(i), transformed.begin());
+                (*options.transforms)(transformed, 0, false);
+                input = transformed.data();
+            }
+
+            evaluation.add(dataset.output(i), mlp.forward(input));
+        }
+    };
+
+    into.reset(mlp.topology().back(), options.k);
+
+    if (options.pool) {
+        const auto initial = into;
+        auto clones = PerWorker<MLPerceptron>(*options.pool, mlp);
+        into = options.pool->parallelReduce(0, dataset.size(), grain, initial,
+            [&](int first, int last) {
+                auto evaluation = initial;
+                add(evaluation, clones.local(), first, last);
+                return evaluation;
+            },
+            [](Evaluation lhs, const Evaluation& rhs) { return lhs += rhs; }
+        );
+        return;
+    }
+
+    // distances of a chunk are summed apart, as they are when merged
+    for (auto first = 0; first < dataset.size(); first += grain) {
+        const auto distance = std::exchange(into.distance, 0.0f);
+        add(into, mlp, first, std::min(dataset.size(), first + grain));
+        into.distance = distance + into.distance;
+    }
+}
+
+inline auto evaluate(
+    const Dataset& dataset,
+    MLPerceptron& mlp,
+    EvaluationOptions options = {}
+) -> Evaluation {
+    auto evaluation = Evaluation();
+    evaluate(dataset, mlp, evaluation, options);
+    return evaluation;
+}
+
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+// element types of idx files, as in the third byte of their magic
+enum class IdxType : std::uint8_t {
+    UInt8 = 0x08,
+    Int8 = 0x09,
+    Int16 = 0x0B,
+    Int32 = 0x0C,
+    Float = 0x0D,
+    Double = 0x0E
+};
+
+struct IdxHeader {
+    IdxType type;
+    std::vector<std::uint32_t> dimensions;
+
+    auto elements() const -> std::uint64_t {
+        return std::ranges::fold_left(dimensions, std::uint64_t(1), std::multiplies<>{});
+    }
+
+    auto elementSize() const -> int {
+        switch (type) {
+            case IdxType::Int16: return 2;
+            case IdxType::Int32: return 4;
+            case IdxType::Float: return 4;
+            case IdxType::Double: return 8;
+            default: return 1;
+        }
+    }
+
+    // of every element past the first dimension, e.g. pixels of an image
+    auto elementsPerItem() const -> std::uint64_t {
+        return dimensions.empty() ? 1 : elements() / std::max<std::uint64_t>(dimensions.front(), 1);
+    }
+};
+
+// Tensors in idx files (big-endian, e.g. MNIST and its relatives) of every
+// element type and rank, converted from and to floats.
+struct Idx {
+
+// header of stream, nullopt when its magic is not one of an idx file
+static auto header(std::istream& stream) -> std::optional<IdxHeader> {
+    auto magic = std::array<std::uint8_t, 4>();
+    if (!stream.read(reinterpret_cast<char*>(magic.data()), magic.size())) {
+        return std::nullopt;
+    }
+
+    const auto type = static_cast<IdxType>(magic[2]);
+    const auto known = std::ranges::find(types, type) != types.end();
+    if (magic[0] != 0 || magic[1] != 0 || !known || magic[3] == 0) {
+        return std::nullopt;
+    }
+
+    auto header = IdxHeader { .type = type };
+    for (auto d = 0; d < magic[3]; ++d) {
+        auto bytes = std::array<std::uint8_t, 4>();
+        if (!stream.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+            return std::nullopt;
+        }
+        header.dimensions.push_back(decode<std::uint32_t>(bytes.data()));
+    }
+
+    if (header.elements() > maxElements) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+static auto write(
+    std::ostream& stream,
+    IdxType type,
+    std::span<const std::uint32_t> dimensions,
+    std::span<const float> values
+) -> bool {
+    auto header = IdxHeader { .type = type, .dimensions = { dimensions.begin(), dimensions.end() } };
+    if (dimensions.empty() || dimensions.size() > 255 || header.elements() != values.size()) {
+        return false;
+    }
+
+    const auto magic = std::array<std::uint8_t, 4> { 0, 0, static_cast<std::uint8_t>(type), static_cast<std::uint8_t>(dimensions.size()) };
+    stream.write(reinterpret_cast<const char*>(magic.data()), magic.size());
+    for (const auto dimension : dimensions) {
+        auto bytes = std::array<std::uint8_t, 4>();
+        encode(dimension, bytes.data());
+        stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    auto buffer = std::vector<std::uint8_t>();
+    for (auto first = 0u; first < values.size(); first += chunk) {
+        const auto chunkValues = values.subspan(first, std::min<std::size_t>(chunk, values.size() - first));
+        buffer.resize(chunkValues.size() * header.elementSize());
+        encode(type, chunkValues, buffer.data());
+        stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    }
+
+    return stream.good();
+}
+
+static auto write(
+    const char* filename,
+    IdxType type,
+    std::span<const std::uint32_t> dimensions,
+    std::span<const float> values
+) -> bool {
+    auto file = std::ofstream(filename, std::ios::binary);
+    return write(file, type, dimensions, values);
+}
+
+// big-endian values of type at bytes into values
+static auto decode(IdxType type, const std::uint8_t* bytes, std::span<float> values) -> void {
+    const auto convert = [&]<typename T>(T) {
+        for (auto& value : values) {
+            value = static_cast<float>(decode<T>(bytes));
+            bytes += sizeof(T);
+        }
+    };
+
+    switch (type) {
+        case IdxType::UInt8: convert(std::uint8_t()); break;
+        case IdxType::Int8: convert(std::int8_t()); break;
+        case IdxType::Int16: convert(std::int16_t()); break;
+        case IdxType::Int32: convert(std::int32_t()); break;
+        case IdxType::Float: convert(float()); break;
+        case IdxType::Double: convert(double()); break;
+    }
+}
+
+// values as big-endian values of type into bytes, integers are rounded and
+// saturated
+static auto encode(IdxType type, std::span<const float> values, std::uint8_t* bytes) -> void {
+    const auto convert = [&]<typename T>(T) {
+        for (const auto value : values) {
+            if constexpr (std::integral<T>) {
+                const auto rounded = std::clamp(
+                    std::round(double(value)),
+                    double(std::numeric_limits<T>::min()),
+                    double(std::numeric_limits<T>::max())
+                );
+                encode(static_cast<T>(rounded), bytes);
+            } else {
+                encode(static_cast<T>(value), bytes);
+            }
+            bytes += sizeof(T);
+        }
+    };
+
+    switch (type) {
+        case IdxType::UInt8: convert(std::uint8_t()); break;
+        case IdxType::Int8: convert(std::int8_t()); break;
+        case IdxType::Int16: convert(std::int16_t()); break;
+        case IdxType::Int32: convert(std::int32_t()); break;
+        case IdxType::Float: convert(float()); break;
+        case IdxType::Double: convert(double()); break;
+    }
+}
+
+// elements converted per read or write of a chunk
+static constexpr auto chunk = 1 << 16;
+
+private:
+
+static constexpr auto types = std::array {
+    IdxType::UInt8, IdxType::Int8, IdxType::Int16, IdxType::Int32, IdxType::Float, IdxType::Double
+};
+
+// guards allocations against corrupted headers
+static constexpr auto maxElements = std::uint64_t(1) << 34;
+
+template<typename T>
+static auto decode(const std::uint8_t* bytes) -> T {
+    using Unsigned = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                     std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                     std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+    auto value = Unsigned();
+    for (auto b = 0u; b < sizeof(T); ++b) {
+        value = static_cast<Unsigned>(value << 8 | bytes[b]);
+    }
+    return std::bit_cast<T>(value);
+}
+
+template<typename T>
+static auto encode(T value, std::uint8_t* bytes) -> void {
+    using Unsigned = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                     std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                     std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+    auto bits = std::bit_cast<Unsigned>(value);
+    for (auto b = sizeof(T); b > 0; --b) {
+        bytes[b - 1] = static_cast<std::uint8_t>(bits);
+        bits = static_cast<Unsigned>(bits >> 8);
+    }
+}
+
+};
+
+// Streaming reads of an idx file's elements in chunks, the file must hold
+// as many elements as its header declares.
+struct IdxReader {
+    IdxReader(const char* filename) : file_(filename, std::ios::binary | std::ios::ate) {
+        const auto size = static_cast<std::uint64_t>(std::max<std::streamoff>(file_.tellg(), 0));
+        file_.seekg(0, std::ios::beg);
+
+        header_ = Idx::header(file_);
+        if (header_) {
+            const auto data = static_cast<std::uint64_t>(file_.tellg());
+            remaining_ = header_->elements();
+            if (size < data || (size - data) / header_->elementSize() < remaining_) {
+                header_ = std::nullopt;
+            }
+        }
+    }
+
+    auto valid() const -> bool { return header_.has_value(); }
+    auto header() const -> const IdxHeader& { return *header_; }
+
+    // elements not read yet
+    auto remaining() const -> std::uint64_t { return remaining_; }
+
+    // next elements into values, returns how many were read; fewer than
+    // values hold only at the end of data or when the file fails
+    auto read(std::span<float> values) -> std::size_t {
+        if (!header_) {
+            return 0;
+        }
+
+        const auto size = header_->elementSize();
+        auto read = std::size_t(0);
+
+        while (read < values.size() && remaining_ > 0) {
+            const auto count = std::min<std::uint64_t>({ values.size() - read, remaining_, std::uint64_t(Idx::chunk) });
+
+            buffer_.resize(count * size);
+            if (!file_.read(reinterpret_cast<char*>(buffer_.data()), buffer_.size())) {
+                remaining_ = 0;
+                break;
+            }
+
+            Idx::decode(header_->type, buffer_.data(), values.subspan(read, count));
+            read += count;
+            remaining_ -= count;
+        }
+        return read;
+    }
+
+private:
+    std::ifstream file_;
+    std::optional<IdxHeader> header_;
+    std::uint64_t remaining_ = 0;
+    std::vector<std::uint8_t> buffer_;
+};
+
+}
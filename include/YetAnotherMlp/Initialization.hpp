@@ -0,0 +1,93 @@
+#pragma once
+
+#include "MLPerceptron.hpp"
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace yam {
+
+enum class Initialization {
+    Separated, // uniform in [-0.5, -0.3] and [0.3, 0.5], weights and biases
+    Xavier,    // uniform in +-sqrt(6 / (fanIn + fanOut)), zero biases, for tanh and sigmoid
+    He         // normal with deviation sqrt(2 / fanIn), zero biases, for relu
+};
+
+// Weights and biases of every layer from their own Philox streams, filled in
+// chunks by the pool's workers. Chunks pick values by index, so the result
+// does not depend on the pool.
+inline auto initialize(
+    MLPerceptron& mlp,
+    Initialization initialization,
+    std::uint64_t seed,
+    ThreadPool* pool = nullptr
+) -> void {
+    static constexpr auto grain = 1 << 16;
+
+    const auto fill = [pool](std::span<float> values, auto&& generate) {
+        if (!pool) {
+            generate(values, 0);
+            return;
+        }
+        pool->parallelFor(0, values.size(), grain, [&](int first, int last) {
+            generate(values.subspan(first, last - first), first);
+        });
+    };
+
+    const auto topology = mlp.topology();
+    auto weights = mlp.weights();
+    auto biases = mlp.biases();
+
+    for (auto layer = 0u; layer + 1 < topology.size(); ++layer) {
+        const auto fanIn = topology[layer];
+        const auto fanOut = topology[layer + 1];
+
+        const auto weightsRandom = Philox(seed, 2 * layer);
+        const auto biasesRandom = Philox(seed, 2 * layer + 1);
+
+        const auto layerWeights = weights.first(fanIn * fanOut);
+        const auto layerBiases = biases.first(biases.empty() ? 0 : fanOut);
+        weights = weights.subspan(layerWeights.size());
+        biases = biases.subspan(layerBiases.size());
+
+        switch (initialization) {
+            case Initialization::Separated: {
+                const auto separated = [](const Philox& random) {
+                    return [random](std::span<float> values, std::uint64_t first) {
+                        random.uniform(values, -0.2f, 0.2f, first);
+                        std::ranges::transform(values, values.begin(), [](float value) {
+                            return value + (value < 0 ? -0.3f : 0.3f);
+                        });
+                    };
+                };
+                fill(layerWeights, separated(weightsRandom));
+                fill(layerBiases, separated(biasesRandom));
+                break;
+            }
+
+            case Initialization::Xavier: {
+                const auto limit = std::sqrt(6.0f / (fanIn + fanOut));
+                fill(layerWeights, [&](std::span<float> values, std::uint64_t first) {
+                    weightsRandom.uniform(values, -limit, limit, first);
+                });
+                std::ranges::fill(layerBiases, 0.0f);
+                break;
+            }
+
+            case Initialization::He: {
+                const auto deviation = std::sqrt(2.0f / fanIn);
+                fill(layerWeights, [&](std::span<float> values, std::uint64_t first) {
+                    weightsRandom.normal(values, 0.0f, deviation, first);
+                });
+                std::ranges::fill(layerBiases, 0.0f);
+                break;
+            }
+        }
+    }
+}
+
+}
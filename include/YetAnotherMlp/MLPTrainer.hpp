@@ -3,17 +3,94 @@
 #include "Activation.hpp"
 #include "Algorit.hpp"
 #include "Dataset.hpp"
+#include "Evaluation.hpp"
+#include "Initialization.hpp"
 #include "MLPerceptron.hpp"
 #include "Random.hpp"
+#include "Regularization.hpp"
 #include "Mathematics.hpp"
+#include "ThreadPool.hpp"
+#include "Transform.hpp"
+#include "WeightLayout.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <optional>
 #include <ranges>
 #include <span>
 
 namespace yam {
 
+enum class Shuffling {
+    Samples, // samples are read in random order from the trainset
+    Blocks,  // random order of contiguous blocks, samples shuffled within a block
+    Staged   // samples are gathered in random order into a staging copy of the trainset
+};
+
+struct TrainerOptions {
+    // evaluation of testset is spread over the pool's workers
+    ThreadPool* pool = nullptr;
+    Shuffling shuffling = Shuffling::Staged;
+
+    // seeded training initializes and shuffles the same way on every run,
+    // reductions are ordered so that thread count does not change the model
+    std::optional<std::uint32_t> seed = std::nullopt;
+
+    // called with the trainee after initialization, every synchronizeEvery
+    // trained samples and with flush at the end of every epoch, e.g. with
+    // DataParallel to keep models of processes training their shards together
+    std::function<void(MLPerceptron&, bool flush)> synchronize = nullptr;
+    int synchronizeEvery = 0;
+
+    // backpropagation keeps activations of every checkpointEvery-th layer only
+    // and recomputes the layers between them, trading up to one more forward
+    // per sample for memory; 0 keeps activations of all layers
+    int checkpointEvery = 0;
+
+    // applied to trainset inputs as they are gathered for training, only
+    // the non-augmenting stages are applied to testset inputs in evaluation
+    Transforms transforms = {};
+
+    // metric deciding when training stops, the error given to the trainer is
+    // its target: the highest error or the lowest (top k) accuracy
+    Metric metric = Metric::Error;
+    int topK = 5;
+
+    // epochs are validated on a random subsample of validationSamples testset
+    // samples (0 takes all) and on the whole testset every fullValidationEvery
+    // epochs and after the last one
+    int validationSamples = 0;
+    int fullValidationEvery = 1;
+
+    // validation runs on a background thread on a copy of the trainee while
+    // the next epoch trains, results then come one epoch late (see
+    // Result::validatedEpoch), except for the last epoch
+    bool asyncValidation = false;
+
+    // hidden layers' weighted sums are normalized (see BatchNorm), which is
+    // folded into the trainee's weights and biases after every epoch, so that
+    // inference pays nothing; the trainee needs biases
+    bool batchNorm = false;
+
+    // fraction of hidden neurons dropped in every trained sample
+    float dropout = 0.0f;
+
+    // of the trainee's weights and biases, Xavier and He are filled in bulk
+    // by the pool's workers
+    Initialization initialization = Initialization::Separated;
+
+    // layout of weights backpropagation works on, panels are packed from the
+    // trainee at the start of every epoch and unpacked into it whenever it is
+    // synchronized and at the end of the epoch; checkpointed and regularized
+    // training keep the row-major layout
+    WeightLayout weightLayout = WeightLayout::RowMajor;
+};
+
 struct MLPTrainer {
+    using Options = TrainerOptions;
+
     MLPTrainer() {}
 
     MLPTrainer(
@@ -23,18 +100,44 @@ struct MLPTrainer {
         int maxEpochs,
         const Dataset& trainset,
         const Dataset& testset,
-        derivation_function derivation
+        derivation_function derivation,
+        Options options = {}
     ) : trainee_(std::move(trainee)),
         learnrate_(learnrate),
         error_(error),
         maxEpochs_(maxEpochs),
         trainset_(trainset),
         testset_(testset),
-        derivation_(derivation)
+        derivations_(trainee_.activations().size(), derivation),
+        options_(options)
     {
 
     }
 
+    // derivations are matched to the trainee's activation types
+    MLPTrainer(
+        MLPerceptron trainee,
+        float learnrate,
+        float error,
+        int maxEpochs,
+        const Dataset& trainset,
+        const Dataset& testset,
+        Options options = {}
+    ) : trainee_(std::move(trainee)),
+        learnrate_(learnrate),
+        error_(error),
+        maxEpochs_(maxEpochs),
+        trainset_(trainset),
+        testset_(testset),
+        options_(options)
+    {
+        std::ranges::transform(
+            trainee_.activations(), 
+            std::back_inserter(derivations_), 
+            &Derivation::function
+        );
+    }
+
     struct Result {
         float targetError;
         int maxEpochs;
@@ -43,8 +146,19 @@ struct MLPTrainer {
         int epoch;
         MLPerceptron* trainee;
 
+        // all metrics of the trainee on testset
+        Evaluation evaluation = {};
+        Metric metric = Metric::Error;
+
+        // epoch the error and evaluation belong to
+        int validatedEpoch = 0;
+
         auto isTrained() const {
-            return error <= targetError || epoch >= maxEpochs;
+            const auto reached = metric == Metric::Error
+                ? error <= targetError
+                : evaluation.metric(metric) >= targetError;
+
+            return reached || epoch >= maxEpochs;
         }
 
         friend auto operator==(
@@ -56,27 +170,56 @@ struct MLPTrainer {
     };
 
     auto begin() {
+        // waits for a background validation left by a previous run
+        validation_ = {};
+
         init(trainset_, trainee_);
 
+        if (normalizing()) {
+            normalized_ = trainee_;
+            norm_ = BatchNorm(trainee_.topology());
+            norm_.fold(normalized_, trainee_);
+        }
+
+        if (options_.synchronize) {
+            options_.synchronize(trained(), true);
+        }
+
         auto initial = Result {
             .targetError = this->error_,
             .maxEpochs = this->maxEpochs_,
 
-            .error = this->error(testset_, trainee_),
+            .error = 0.0f,
             .epoch = 0,
-            .trainee = std::addressof(trainee_)
+            .trainee = std::addressof(trainee_),
+            .metric = options_.metric
         };
 
+        evaluate(testset_, trainee_, initial.evaluation);
+        initial.error = initial.evaluation.error();
+
         return Algorit(
             initial,
             [this](auto&& i) { return true; },
             [this](auto&& i) { 
-                std::random_shuffle(indexes_.begin(), indexes_.end());
+                shuffle();
+
+                if (options_.shuffling == Shuffling::Staged) {
+                    train(trained(), staged_, std::views::iota(0, staged_.size()), derivations_, learnrate_);
+                } else {
+                    train(trained(), trainset_, indexes_, derivations_, learnrate_, !options_.transforms.empty());
+                }
 
-                train(trainee_, trainset_, derivation_, learnrate_);
+                if (options_.synchronize) {
+                    options_.synchronize(trained(), true);
+                }
+
+                if (normalizing()) {
+                    norm_.fold(normalized_, trainee_);
+                }
 
-                i.error = this->error(testset_, trainee_);
                 i.epoch++;
+                validate(i);
             }
         );
     }
@@ -97,58 +240,259 @@ struct MLPTrainer {
 
     auto trainee() -> MLPerceptron& { return trainee_; }
 
+    // bytes of activations, errors and derivatives backpropagation works on
+    auto stateBytes() const -> std::size_t {
+        const auto activations = checkpointed()
+            ? checkpoints_.size() + segment_.size()
+            : trainee_.neurons().size();
+
+        return (activations + errors_.size() + derived_.size()) * sizeof(float);
+    }
+
 private:
+    // perceptron backpropagation runs on, the trainee is its folded copy
+    // with batch normalization
+    auto trained() -> MLPerceptron& { return normalizing() ? normalized_ : trainee_; }
+
+    // convolutional trainees train on the row-major path only, without
+    // regularization, checkpoints nor panels
+    auto convolutional() const -> bool { return trainee_.convolution(); }
+
+    auto normalizing() const -> bool { return options_.batchNorm && !convolutional(); }
+
+    auto regularized() const -> bool {
+        return (options_.batchNorm || options_.dropout > 0.0f) && !convolutional();
+    }
+
+    // checkpointing does not apply to regularized training
+    auto checkpointed() const -> bool {
+        return options_.checkpointEvery > 0 && !regularized() && !convolutional();
+    }
+
+    auto paneled() const -> bool {
+        return options_.weightLayout == WeightLayout::Panels && !checkpointed() && !regularized() && !convolutional();
+    }
+
+    template<std::ranges::input_range Order>
     auto train(
         MLPerceptron& trainee, 
         const Dataset& dataset,
-        derivation_function derivation,
-        float learnrate
+        Order&& order,
+        std::span<const derivation_function> derivations,
+        float learnrate,
+        bool transform = false
     ) const -> void {
-        for(const auto i : indexes_) {
-            const auto input = dataset.input(i).begin().base();
+        if (paneled()) {
+            panels_.pack(trainee.weights());
+        }
+
+        auto trained = 0;
+        for(const auto i : order) {
+            auto input = dataset.input(i).begin().base();
+            if (transform) {
+                transformed_.assign(input, input + dataset.inputSize());
+                options_.transforms(transformed_, epochKey_ | i);
+                input = transformed_.data();
+            }
+
             const auto expected = dataset.output(i).begin().base();
-            backpropagate(trainee, learnrate, input, expected, derivation);
+            if (checkpointed()) {
+                backpropagateCheckpointed(trainee, learnrate, input, expected, derivations);
+            } else if (paneled()) {
+                backpropagatePanels(trainee, learnrate, input, expected, derivations);
+            } else {
+                backpropagate(trainee, learnrate, input, expected, derivations, epochKey_ | i);
+            }
+
+            if (options_.synchronize && ++trained == options_.synchronizeEvery) {
+                if (paneled()) {
+                    panels_.unpack(trainee.weights());
+                }
+
+                options_.synchronize(trainee, false);
+                trained = 0;
+
+                if (paneled()) {
+                    panels_.pack(trainee.weights());
+                }
+            }
+        }
+
+        if (paneled()) {
+            panels_.unpack(trainee.weights());
         }
     }
 
     auto init(const Dataset& dataset, MLPerceptron& trainee) const -> void {
-        errors_.resize(trainee.neurons().size());
-        derived_.resize(errors_.size());
+        if (checkpointed()) {
+            initCheckpoints(trainee.topology());
+        } else {
+            errors_.resize(trainee.neurons().size());
+            derived_.resize(errors_.size());
+        }
+        masks_.resize(options_.dropout > 0.0f ? std::ranges::max(trainee.topology()) : 0);
+        panels_ = paneled() ? PanelWeights(trainee.topology()) : PanelWeights();
+        convolutionErrors_.resize(convolutional() ? trainee.topology().front() : 0);
         indexes_.resize(dataset.size());
 
         std::ranges::copy(std::views::iota(0u, indexes_.size()), indexes_.begin());
 
-        auto rnd = Random();
+        random_ = options_.seed ? Random(*options_.seed) : Random();
+        // own generator, so that validation settings do not change training
+        subsampleRandom_ = options_.seed ? Random(*options_.seed + 1) : Random();
+
+        // separated values keep coming from random_, as seeded models did
+        if (options_.initialization == Initialization::Separated) {
+            random_.separated(0.3f, 0.2f, trainee.weights());
+            random_.separated(0.3f, 0.2f, trainee.biases());
+        } else {
+            initialize(trainee, options_.initialization, random_(0u, ~0u), options_.pool);
+        }
 
-        rnd.separated(0.3f, 0.2f, trainee.weights());
-        rnd.separated(0.3f, 0.2f, trainee.biases());
+        // kernels of relu feature maps, He initialized
+        if (const auto convolution = trainee.convolution()) {
+            const auto shape = convolution->shape();
+            const auto patch = shape.channels * shape.kernel * shape.kernel;
+            Philox(random_(0u, ~0u)).normal(convolution->kernels(), 0.0f, std::sqrt(2.0f / patch));
+            std::ranges::fill(convolution->biases(), 0.0f);
+        }
     }
 
-    auto error(
-        const Dataset& dataset,
-        MLPerceptron& mlp
-    ) const -> float {
-        auto errors = std::views::iota(0, dataset.size()) | std::views::transform([&](auto i) {
-            const auto input = dataset.input(i).begin().base();
-            const auto expected = dataset.output(i);
-            const auto actual = mlp.forward(input).begin().base();
-            return yam::distance(expected, actual);
+    auto shuffle() const -> void {
+        // new random choices of augmentations and dropout every epoch, keyed by sample
+        if (!options_.transforms.empty() || options_.dropout > 0.0f) {
+            epochKey_ = std::uint64_t(random_(0u, ~0u)) << 32;
+        }
+
+        switch (options_.shuffling) {
+            case Shuffling::Samples:
+                random_.shuffle(indexes_);
+                break;
+
+            case Shuffling::Blocks:
+                shuffleBlocks(trainset_);
+                break;
+
+            case Shuffling::Staged:
+                random_.shuffle(indexes_);
+                stage(trainset_);
+                break;
+        }
+    }
+
+    // gathers shuffled dataset into staged_ transforming samples on the way,
+    // in parallel chunks when there is a pool
+    auto stage(const Dataset& dataset) const -> void {
+        if (options_.transforms.empty()) {
+            dataset.gather(indexes_, staged_);
+            return;
+        }
+
+        const auto transform = [this](int k, std::span<float> input) {
+            options_.transforms(input, epochKey_ | indexes_[k]);
+        };
+
+        if (!options_.pool) {
+            dataset.gather(indexes_, staged_, transform);
+            return;
+        }
+
+        dataset.shape(indexes_.size(), staged_);
+        options_.pool->parallelFor(0, indexes_.size(), stagingGrain, [&](int first, int last) {
+            dataset.gather(indexes_, staged_, first, last, transform);
         });
+    }
+
+    auto shuffleBlocks(const Dataset& dataset) const -> void {
+        const auto sampleBytes = (dataset.inputSize() + dataset.outputSize()) * sizeof(float);
+        const auto block = std::max<int>(1, blockBytes / std::max<std::size_t>(sampleBytes, 1));
+        const auto blocks = (dataset.size() + block - 1) / block;
+
+        blocks_.resize(blocks);
+        std::ranges::copy(std::views::iota(0, blocks), blocks_.begin());
+        random_.shuffle(blocks_);
+
+        auto index = indexes_.begin();
+        for (const auto b : blocks_) {
+            const auto first = index;
+            index = std::ranges::copy(
+                std::views::iota(b * block, std::min(dataset.size(), (b + 1) * block)), 
+                index
+            ).out;
+            random_.shuffle(std::ranges::subrange(first, index));
+        }
+    }
+
+    auto validate(Result& result) -> void {
+        const auto last = result.epoch >= maxEpochs_;
+        const auto full = options_.validationSamples <= 0
+            || options_.validationSamples >= testset_.size()
+            || result.epoch % std::max(options_.fullValidationEvery, 1) == 0
+            || last;
 
-        return std::ranges::fold_left(errors, 0.0f, std::plus<>{}) / dataset.size();
+        // the subsample may still be read by the background validation
+        if (validation_.valid()) {
+            std::tie(result.evaluation, result.validatedEpoch) = validation_.get();
+        }
+
+        const auto& dataset = full ? testset_ : subsample();
+
+        if (options_.asyncValidation && !last) {
+            validation_ = std::async(std::launch::async, [this, &dataset, snapshot = trainee_, epoch = result.epoch] () mutable {
+                auto evaluation = Evaluation();
+                evaluate(dataset, snapshot, evaluation);
+                return std::make_pair(std::move(evaluation), epoch);
+            });
+        } else {
+            evaluate(dataset, trainee_, result.evaluation);
+            result.validatedEpoch = result.epoch;
+        }
+
+        result.error = result.evaluation.error();
+    }
+
+    // random part of testset gathered into subsample_
+    auto subsample() const -> const Dataset& {
+        if (subsampleIndexes_.size() != testset_.size()) {
+            subsampleIndexes_.resize(testset_.size());
+            std::ranges::copy(std::views::iota(0, testset_.size()), subsampleIndexes_.begin());
+        }
+
+        subsampleRandom_.shuffle(subsampleIndexes_);
+        testset_.gather(std::span(subsampleIndexes_).first(options_.validationSamples), subsample_);
+        return subsample_;
+    }
+
+    auto evaluate(const Dataset& dataset, MLPerceptron& mlp, Evaluation& into) const -> void {
+        yam::evaluate(dataset, mlp, into, {
+            .k = options_.topK,
+            .pool = options_.pool,
+            .transforms = std::addressof(options_.transforms)
+        });
     }
-    
+
     void backpropagate(
         MLPerceptron& trainee,
         float learnrate,
         const float* input,
         const float* expected,
-        derivation_function derivative
+        std::span<const derivation_function> derivations,
+        std::uint64_t key
     ) const {
-        const auto actual = trainee.forward(input).begin().base();
+        const auto regularized = this->regularized();
+        const auto actual = regularized
+            ? forwardRegularized(trainee, input, derivations, key)
+            : trainee.forward(input).begin().base();
         const auto topology = trainee.topology();
 
-        derivative(trainee.neurons(), derived_.begin().base());
+        if (!regularized) {
+            auto signal = trainee.neurons().begin().base();
+            auto derived = derived_.begin().base();
+            for (const auto [derivative, size] : std::views::zip(derivations, topology | std::views::drop(1))) {
+                derived = derivative({signal, signal + size}, derived);
+                signal += size;
+            }
+        }
 
         struct Pointers {
             float* error;
@@ -185,10 +529,16 @@ private:
         | std::views::reverse
         | std::views::adjacent<2>;
 
+        auto lower = static_cast<int>(topology.size()) - 2;
         for (const auto& layer : layers) {
             pointers -= layer;
 
             hiddenLayerError(pointers.error, pointers.derived, pointers.weight, layer.second, layer.first);
+            if (options_.batchNorm) {
+                norm_.backward(lower, {pointers.error, pointers.error + layer.second}, learnrate);
+            }
+            --lower;
+
             correct(pointers.error + layer.second, pointers.weight, pointers.bias, pointers.signal, learnrate, layer.second, layer.first);
         }
 
@@ -197,7 +547,225 @@ private:
 
         pointers -= {uc, lc};
 
-        correct(pointers.error + lc, pointers.weight, pointers.bias, input, learnrate, lc, uc);
+        // the first dense layer's inputs are feature maps of the convolution,
+        // their errors come from its weights before they are corrected
+        const auto convolution = trainee.convolution();
+        if (convolution) {
+            transposedMatmul(pointers.weight, pointers.error + lc, convolutionErrors_.begin().base(), uc, lc);
+            input = convolution->output().begin().base();
+        }
+
+        if (!regularized && trainee.sparseInput()) {
+            correct(pointers.error + lc, pointers.weight, pointers.bias, input, trainee.inputIndexes(), learnrate, lc, uc);
+        } else {
+            correct(pointers.error + lc, pointers.weight, pointers.bias, input, learnrate, lc, uc);
+        }
+
+        if (convolution) {
+            convolution->backward(convolutionErrors_.begin().base(), learnrate);
+        }
+    }
+
+    // forward leaving activations in neurons() and their derivatives in
+    // derived_, with hidden layers normalized and dropped out
+    auto forwardRegularized(
+        MLPerceptron& trainee,
+        const float* input,
+        std::span<const derivation_function> derivations,
+        std::uint64_t key
+    ) const -> const float* {
+        const auto topology = trainee.topology();
+        const auto layers = static_cast<int>(topology.size()) - 1;
+        const auto dropout = Dropout { .rate = options_.dropout };
+        const auto dropoutKey = SampleRandom(key)();
+
+        auto lower = input;
+        auto upper = trainee.neurons().begin().base();
+        auto derived = derived_.begin().base();
+        for (auto j = 1; j <= layers; ++j) {
+            const auto size = topology[j];
+            const auto hidden = j < layers;
+            const auto normalized = hidden && options_.batchNorm;
+
+            trainee.forward(j - 1, lower, upper, !normalized);
+            if (normalized) {
+                norm_.forward(j, {upper, upper + size});
+                trainee.activation(j - 1)({upper, upper + size}, upper);
+            }
+
+            derivations[j - 1]({upper, upper + size}, derived);
+
+            if (hidden && dropout.rate > 0.0f) {
+                dropout.mask({masks_.begin().base(), masks_.begin().base() + size}, dropoutKey + j);
+                for (auto n = 0; n < size; ++n) {
+                    upper[n] *= masks_[n];
+                    derived[n] *= masks_[n];
+                }
+            }
+
+            lower = upper;
+            upper += size;
+            derived += size;
+        }
+        return lower;
+    }
+
+    // layers are split into segments of checkpointEvery layers, the top layer
+    // of every segment but the last one is a checkpoint, segment_ holds
+    // activations of the one segment being backpropagated
+    auto initCheckpoints(std::span<const int> topology) const -> void {
+        const auto layers = static_cast<int>(topology.size()) - 1;
+        const auto every = options_.checkpointEvery;
+        const auto widest = std::ranges::max(topology);
+
+        auto checkpoints = 0;
+        auto segment = 0;
+        for (auto bottom = 0; bottom < layers; bottom += every) {
+            const auto top = std::min(bottom + every, layers);
+            const auto widths = topology.subspan(bottom + 1, top - bottom);
+            segment = std::max(segment, std::ranges::fold_left(widths, 0, std::plus<>{}));
+            checkpoints += top < layers ? topology[top] : 0;
+        }
+
+        checkpoints_.resize(checkpoints);
+        segment_.resize(segment);
+        signals_.resize(topology.size());
+        errors_.resize(2 * widest);
+        derived_.resize(widest);
+    }
+
+    // activations of segment's layers from its bottom one, input or checkpoint
+    auto recompute(const MLPerceptron& trainee, const float* input, int segment) const -> void {
+        const auto topology = trainee.topology();
+        const auto layers = static_cast<int>(topology.size()) - 1;
+        const auto every = options_.checkpointEvery;
+        const auto bottom = segment * every;
+
+        auto checkpoint = checkpoints_.begin().base();
+        for (auto s = 1; s < segment; ++s) {
+            checkpoint += topology[s * every];
+        }
+
+        signals_[bottom] = segment == 0 ? input : checkpoint;
+
+        auto upper = segment_.begin().base();
+        for (auto j = bottom + 1; j <= std::min(bottom + every, layers); ++j) {
+            trainee.forward(j - 1, signals_[j - 1], upper);
+            signals_[j] = upper;
+            upper += topology[j];
+        }
+    }
+
+    void backpropagateCheckpointed(
+        MLPerceptron& trainee,
+        float learnrate,
+        const float* input,
+        const float* expected,
+        std::span<const derivation_function> derivations
+    ) const {
+        const auto topology = trainee.topology();
+        const auto layers = static_cast<int>(topology.size()) - 1;
+        const auto every = options_.checkpointEvery;
+        const auto segments = (layers + every - 1) / every;
+
+        // forward storing tops of segments as checkpoints
+        auto checkpoint = checkpoints_.begin().base();
+        for (auto s = 0; s < segments; ++s) {
+            recompute(trainee, input, s);
+            if (s + 1 < segments) {
+                const auto top = (s + 1) * every;
+                checkpoint = std::copy_n(signals_[top], topology[top], checkpoint);
+            }
+        }
+
+        auto weight = trainee.weights().end().base();
+        auto bias = trainee.biases().end().base();
+
+        // errors of upper layer follow errors of lower one
+        auto error = errors_.begin().base();
+        const auto derived = derived_.begin().base();
+
+        derivations.back()({signals_[layers], signals_[layers] + topology.back()}, derived);
+        lastLayerError(error + topology[layers - 1], derived, signals_[layers], expected, topology.back());
+
+        auto segment = segments - 1;
+        for (auto j = layers; j > 0; --j) {
+            const auto lc = topology[j - 1];
+            const auto uc = topology[j];
+
+            if ((j - 1) / every != segment) {
+                segment = (j - 1) / every;
+                recompute(trainee, input, segment);
+            }
+
+            weight -= lc * uc;
+            bias -= bias ? uc : 0;
+
+            if (j > 1) {
+                const auto signal = signals_[j - 1];
+                derivations[j - 2]({signal, signal + lc}, derived);
+                hiddenLayerError(error, derived, weight, lc, uc);
+            }
+
+            correct(error + lc, weight, bias, signals_[j - 1], learnrate, lc, uc);
+
+            if (j > 1) {
+                std::copy_backward(error, error + lc, error + topology[j - 2] + lc);
+            }
+        }
+    }
+
+    // backpropagation over panels_, activations and errors are laid out as
+    // in backpropagate
+    void backpropagatePanels(
+        MLPerceptron& trainee,
+        float learnrate,
+        const float* input,
+        const float* expected,
+        std::span<const derivation_function> derivations
+    ) const {
+        const auto topology = trainee.topology();
+        const auto layers = static_cast<int>(topology.size()) - 1;
+        const auto neurons = trainee.neurons().begin().base();
+        const auto biases = trainee.biases().begin().base();
+        const auto bias = !trainee.biases().empty();
+
+        // offset of layer's neurons, signals start with the first hidden layer
+        const auto offset = [&](int layer) {
+            return std::ranges::fold_left(topology.subspan(1, layer - 1), 0, std::plus<>{});
+        };
+
+        for (auto j = 1; j <= layers; ++j) {
+            const auto upper = neurons + offset(j);
+            const auto size = topology[j];
+
+            panels_.forward(j - 1, j == 1 ? input : neurons + offset(j - 1), upper);
+            for (auto b = bias ? 0 : size; b < size; ++b) {
+                upper[b] += biases[offset(j) + b];
+            }
+            trainee.activation(j - 1)({upper, upper + size}, upper);
+            derivations[j - 1]({upper, upper + size}, derived_.begin().base() + offset(j));
+        }
+
+        const auto top = offset(layers);
+        lastLayerError(errors_.begin().base() + top, derived_.begin().base() + top, neurons + top, expected, topology.back());
+
+        for (auto j = layers; j > 0; --j) {
+            const auto error = errors_.begin().base() + offset(j);
+            const auto lower = j > 1 ? offset(j - 1) : 0;
+
+            if (j > 1) {
+                panels_.transposed(j - 1, error, errors_.begin().base() + lower);
+                for (auto l = 0; l < topology[j - 1]; ++l) {
+                    errors_[lower + l] *= derived_[lower + l];
+                }
+            }
+
+            panels_.correct(j - 1, error, j == 1 ? input : neurons + lower, learnrate);
+            for (auto b = bias ? 0 : topology[j]; b < topology[j]; ++b) {
+                biases[offset(j) + b] += learnrate * error[b];
+            }
+        }
     }
 
     void lastLayerError(
@@ -219,29 +787,43 @@ private:
         int lc,
         int uc
     ) const {
-        for(auto u = 0u; u < uc; ++u) {
-            for (auto l = 0u; l < lc; ++l) {    
-                error[l] += *weight++ * error[lc + u];
-            }
+        transposedMatmul(weight, error + lc, error, uc, lc);
+        Simd::multiply(derived, error, lc);
+    }
+
+    void correct(
+        const float* error,
+              float* weight,
+              float* bias,
+        const float* signal,
+        float learnrate,
+        int lc,
+        int uc
+    ) const {
+        for (auto u = 0; u < uc; ++u, weight += lc) {
+            Simd::axpy(learnrate * error[u], signal, weight, lc);
         }
 
-        for (auto l = 0u; l < lc; ++l) {    
-            error[l] *= derived[l];
+        for (auto b = bias ? 0u : uc; b < uc; ++b) {
+            bias[b] += learnrate * error[b];
         }
     }
 
+    // updates only columns of nonzero signals
     void correct(
         const float* error,
               float* weight,
               float* bias,
         const float* signal,
+        std::span<const int> nonzeros,
         float learnrate,
         int lc,
         int uc
     ) const {
-        for (auto u = 0u; u < uc; ++u) {
-            for (auto l = 0u; l < lc; ++l) {
-                *weight++ += learnrate * error[u] * signal[l];
+        for (auto u = 0u; u < uc; ++u, weight += lc) {
+            const auto delta = learnrate * error[u];
+            for (const auto l : nonzeros) {
+                weight[l] += delta * signal[l];
             }
         }
 
@@ -250,9 +832,31 @@ private:
         }
     }
 
+    static constexpr auto stagingGrain = 256;
+
+    // a block of samples shuffled together fits into L2 cache
+    static constexpr auto blockBytes = 256u * 1024u;
+
     mutable std::vector<float> errors_;
     mutable std::vector<float> derived_;
+    mutable std::vector<float> checkpoints_;
+    mutable std::vector<float> segment_;
+    mutable std::vector<const float*> signals_;
     mutable std::vector<int> indexes_;
+    mutable std::vector<int> blocks_;
+    mutable Dataset staged_;
+    mutable Random random_;
+    mutable std::uint64_t epochKey_ = 0;
+    mutable std::vector<float> transformed_;
+    mutable std::vector<int> subsampleIndexes_;
+    mutable Random subsampleRandom_;
+    mutable Dataset subsample_;
+    mutable std::future<std::pair<Evaluation, int>> validation_;
+    mutable BatchNorm norm_;
+    mutable std::vector<float> masks_;
+    mutable PanelWeights panels_;
+    mutable std::vector<float> convolutionErrors_;
+    MLPerceptron normalized_;
 
     MLPerceptron trainee_;
     float learnrate_;
@@ -260,7 +864,8 @@ private:
     int maxEpochs_;
     Dataset trainset_;
     Dataset testset_;
-    derivation_function derivation_;
+    std::vector<derivation_function> derivations_;
+    Options options_;
 };
 
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "Activation.hpp"
+#include "Convolution.hpp"
 #include "Mathematics.hpp"
+#include "ThreadPool.hpp"
 #include "Utils.hpp"
 
 #include <functional>
+#include <memory>
+#include <optional>
 
 namespace yam {
 
@@ -28,42 +32,97 @@ struct MLPerceptron {
         activation_function activation
     ) : MLPerceptron(true, topology, bias, activation) {}
 
+    // one activation per layer, single one is shared by all layers
+    template<Integers Topology>
+    MLPerceptron(
+        Topology&& topology,
+        bool bias,
+        std::vector<ActivationFunctionType> activations
+    ) : MLPerceptron(true, topology, bias, activations) {}
+
+    template<std::integral I>
+    MLPerceptron(
+        std::initializer_list<I> topology,
+        bool bias,
+        std::vector<ActivationFunctionType> activations
+    ) : MLPerceptron(true, topology, bias, activations) {}
+
     auto forward(const float* input) -> std::span<const float> {
-        auto lower = input;
-        auto upper = neurons_.begin().base();
-        auto last  = neurons_.end().base();
-        auto weight = weights_.begin();
-        auto bias = biases_.begin().base();
+        if (convolution_) {
+            input = convolution_->forward(input).begin().base();
+        }
 
-        std::fill(upper, last, 0);
+        auto layer = Layer {
+            .lower = input,
+            .upper = neurons_.begin().base(),
+            .weight = weights_.begin().base(),
+            .bias = biases_.begin().base(),
+            .activation = activations_.begin().base(),
+            .sparse = gather(input, topology_.front())
+        };
 
         for (const auto [lc, uc] : std::views::adjacent<2>(topology_)) {
-            // for (auto u = 0; u < uc; ++u) {
-            //     for (auto l = 0; l < lc; ++l) {
-            //         upper[u] += *weight++ * lower[l];
-            //     }
-            // }
-
-            matmul(
-                std::span(weight, weight + uc * lc),
-                std::span(lower, lower + lc),
-                upper,
-                lc
-            );
-
-            for (auto u = bias ? 0 : uc; u < uc; ++u) {
-                upper[u] += *bias++;
+            layer.lc = lc;
+            layer.uc = uc;
+
+            if (pool_ && lc * uc >= parallelThreshold_) {
+                const auto grain = (uc + pool_->size()) / (pool_->size() + 1);
+                pool_->parallelFor(0, uc, grain, [this, &layer](int first, int last) {
+                    forward(layer, first, last);
+                });
+            } else {
+                forward(layer, 0, uc);
             }
 
-            lower = upper;
-            upper = activation_({upper, upper + uc}, upper);
+            layer.weight += uc * lc;
+            layer.bias += layer.bias ? uc : 0;
+            layer.activation++;
+            layer.lower = layer.upper;
+            layer.upper += uc;
+            layer.sparse = false;
         }
 
-        return {lower, last};
+        return {layer.lower, layer.upper};
+    }
+
+    // activations of layer + 1 computed from given activations of layer,
+    // neurons() are left untouched, e.g. when training recomputes a layer;
+    // without activate upper gets the weighted sums
+    auto forward(int layer, const float* lower, float* upper, bool activate = true) const -> void {
+        auto current = Layer {
+            .lower = lower,
+            .upper = upper,
+            .weight = weights_.begin().base(),
+            .bias = biases_.begin().base(),
+            .activation = activate ? activations_.begin().base() + layer : nullptr,
+            .lc = topology_[layer],
+            .uc = topology_[layer + 1],
+            .sparse = false
+        };
+
+        for (const auto [lc, uc] : std::views::adjacent<2>(topology_) | std::views::take(layer)) {
+            current.weight += lc * uc;
+            current.bias += current.bias ? uc : 0;
+        }
+
+        forward(current, 0, current.uc);
+    }
+
+    // single forward splits neurons of layers having at least threshold
+    // weights over pool's workers, nullptr pool keeps forward serial
+    auto parallelize(ThreadPool* pool, int threshold = 1 << 16) -> void {
+        pool_ = pool;
+        parallelThreshold_ = threshold;
     }
 
     auto topology() const -> std::span<const int> { return topology_; }
 
+    // front end turning images into inputs of the first dense layer, whose
+    // size is the convolution's output size; forward takes images then
+    auto convolution() const -> const Convolution* { return convolution_ ? std::addressof(*convolution_) : nullptr; }
+    auto convolution()       ->       Convolution* { return convolution_ ? std::addressof(*convolution_) : nullptr; }
+    auto convolution(Convolution convolution) -> void { convolution_ = std::move(convolution); }
+
     auto neurons() const -> std::span<const float> { return neurons_; }
     auto neurons()       -> std::span<      float> { return neurons_; }
 
@@ -73,15 +132,114 @@ struct MLPerceptron {
     auto biases() const -> std::span<const float> { return biases_; }
     auto biases()       -> std::span<      float> { return biases_; }
 
+    auto activations() const -> std::span<const ActivationFunctionType> { return types_; }
+    auto activation(int layer) const -> const activation_function& { return activations_[layer]; }
+
+    // inputs with at most this fraction of nonzeros skip zero columns
+    // in the first layer, 0 leaves only all-zero inputs on the sparse path
+    auto sparseDensity() const -> float { return sparseDensity_; }
+    auto sparseDensity(float density) -> void { sparseDensity_ = density; }
+
+    // nonzero input indexes of the last forward, valid when sparseInput() holds
+    auto sparseInput() const -> bool { return sparse_; }
+    auto inputIndexes() const -> std::span<const int> { return inputIndexes_; }
+
 private:
+    struct Layer {
+        const float* lower;
+        float* upper;
+        const float* weight;
+        const float* bias;
+        const activation_function* activation;
+        int lc;
+        int uc;
+        bool sparse;
+    };
+
+    // computes neurons [first, last) of the layer
+    auto forward(const Layer& layer, int first, int last) const -> void {
+        const auto [lower, upper, weight, bias, activation, lc, uc, sparse] = layer;
+
+        if (sparse) {
+            sparseMatmul(weight + first * lc, upper + first, lc, last - first);
+        } else {
+            for (auto u = first; u < last; ++u) {
+                upper[u] = Simd::dot(weight + u * lc, lower, lc);
+            }
+        }
+
+        for (auto u = bias ? first : last; u < last; ++u) {
+            upper[u] += bias[u];
+        }
+
+        if (activation) {
+            (*activation)({upper + first, upper + last}, upper + first);
+        }
+    }
+
+    auto gather(const float* input, int size) -> bool {
+        inputIndexes_.clear();
+        inputValues_.clear();
+
+        const auto limit = static_cast<std::size_t>(sparseDensity_ * size);
+
+        for (auto i = 0; i < size && inputIndexes_.size() <= limit; ++i) {
+            if (input[i] != 0) {
+                inputIndexes_.push_back(i);
+                inputValues_.push_back(input[i]);
+            }
+        }
+
+        sparse_ = inputIndexes_.size() <= limit;
+        return sparse_;
+    }
+
+    auto sparseMatmul(const float* weight, float* upper, int lc, int uc) const -> void {
+        const auto nonzeros = inputIndexes_.size();
+
+        for (auto u = 0; u < uc; ++u, weight += lc) {
+            auto sum = 0.0f;
+            for (auto i = 0u; i < nonzeros; ++i) {
+                sum += weight[inputIndexes_[i]] * inputValues_[i];
+            }
+            upper[u] = sum;
+        }
+    }
+
     template<Integers Topology>
     MLPerceptron(
         bool,
         Topology&& topology,
         bool bias,
         activation_function activation
-    ) : topology_(std::begin(topology), std::end(topology)),
-        activation_(activation)
+    ) : MLPerceptron(true, topology, bias)
+    {
+        activations_.assign(topology_.size() - 1, activation);
+        types_.assign(activations_.size(), ActivationFunctionType::Custom);
+    }
+
+    template<Integers Topology>
+    MLPerceptron(
+        bool,
+        Topology&& topology,
+        bool bias,
+        const std::vector<ActivationFunctionType>& activations
+    ) : MLPerceptron(true, topology, bias)
+    {
+        types_.resize(topology_.size() - 1, activations.front());
+        if (activations.size() > 1) {
+            std::ranges::copy(activations | std::views::take(types_.size()), types_.begin());
+        }
+
+        std::ranges::transform(types_, std::back_inserter(activations_), &Activation::function);
+    }
+
+    template<Integers Topology>
+    MLPerceptron(
+        bool,
+        Topology&& topology,
+        bool bias
+    ) : topology_(std::begin(topology), std::end(topology))
     {
         const auto [neurons, weights] = std::ranges::fold_left(
             std::views::adjacent<2>(topology_),
@@ -103,7 +261,15 @@ private:
     std::vector<float> neurons_;
     std::vector<float> weights_;
     std::vector<float> biases_;
-    activation_function activation_;
+    std::vector<activation_function> activations_;
+    std::vector<ActivationFunctionType> types_;
+    std::optional<Convolution> convolution_;
+    std::vector<int> inputIndexes_;
+    std::vector<float> inputValues_;
+    float sparseDensity_ = 0.5f;
+    bool sparse_ = false;
+    ThreadPool* pool_ = nullptr;
+    int parallelThreshold_ = 0;
 };
 
 }
\ No newline at end of file
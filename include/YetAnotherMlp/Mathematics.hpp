@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Simd.hpp"
+
+#include <algorithm>
 #include <concepts>
 #include <iterator>
 #include <numeric>
@@ -95,4 +98,16 @@ auto matmul(
     );
 }
 
-}
\ No newline at end of file
+// product = transposed(matrix) * vector for row-major matrix of rows x cols,
+// vectorized for the CPU's instruction set
+inline auto transposedMatmul(
+    const float* matrix,
+    const float* vector,
+    float* product,
+    int rows,
+    int cols
+) -> void {
+    Simd::transposedMatmul(matrix, vector, product, rows, cols);
+}
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Activation.hpp"
+#include "MLPerceptron.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+// Trained perceptrons in a binary file: magic, topology, bias flag,
+// activation type of every layer, weights and biases as host floats.
+// Custom activations cannot be stored, as they are arbitrary functions,
+// nor can convolutional front ends.
+struct Model {
+
+static constexpr auto magicNumber = std::uint32_t(0x316d6179); // "yam1"
+
+static auto save(
+    const MLPerceptron& mlp,
+    std::ostream& stream
+) -> bool {
+    const auto activations = mlp.activations();
+    if (std::ranges::find(activations, ActivationFunctionType::Custom) != activations.end() || mlp.convolution()) {
+        return false;
+    }
+
+    write(stream, magicNumber);
+    write(stream, static_cast<std::uint32_t>(mlp.topology().size()));
+    for (const auto size : mlp.topology()) {
+        write(stream, static_cast<std::uint32_t>(size));
+    }
+
+    write(stream, static_cast<std::uint8_t>(!mlp.biases().empty()));
+    for (const auto type : activations) {
+        write(stream, static_cast<std::uint8_t>(type));
+    }
+
+    write(stream, mlp.weights());
+    write(stream, mlp.biases());
+
+    return stream.good();
+}
+
+static auto save(
+    const MLPerceptron& mlp,
+    const char* filename
+) -> bool {
+    auto file = std::ofstream(filename, std::ios::binary);
+    return save(mlp, file);
+}
+
+static auto load(std::istream& stream) -> std::optional<MLPerceptron> {
+    const auto magic = read<std::uint32_t>(stream);
+    const auto layers = read<std::uint32_t>(stream);
+    if (!magic || *magic != magicNumber || !layers || *layers < 2 || *layers > maxLayers) {
+        return std::nullopt;
+    }
+
+    auto topology = std::vector<int>();
+    for (auto l = 0u; l < *layers; ++l) {
+        const auto size = read<std::uint32_t>(stream);
+        if (!size || *size == 0 || *size > maxLayerSize) {
+            return std::nullopt;
+        }
+        topology.push_back(*size);
+    }
+
+    const auto bias = read<std::uint8_t>(stream);
+    if (!bias) {
+        return std::nullopt;
+    }
+
+    auto activations = std::vector<ActivationFunctionType>();
+    for (auto l = 1u; l < *layers; ++l) {
+        const auto type = read<std::uint8_t>(stream);
+        if (!type || *type >= static_cast<std::uint8_t>(ActivationFunctionType::Custom)) {
+            return std::nullopt;
+        }
+        activations.push_back(static_cast<ActivationFunctionType>(*type));
+    }
+
+    auto mlp = MLPerceptron(topology, *bias != 0, activations);
+
+    if (!read(stream, mlp.weights()) || !read(stream, mlp.biases())) {
+        return std::nullopt;
+    }
+
+    return mlp;
+}
+
+static auto load(const char* filename) -> std::optional<MLPerceptron> {
+    auto file = std::ifstream(filename, std::ios::binary);
+    return load(file);
+}
+
+private:
+
+// guards allocations against corrupted headers
+static constexpr auto maxLayers = 1u << 16;
+static constexpr auto maxLayerSize = 1u << 24;
+
+template<typename T>
+static auto write(std::ostream& stream, T value) -> void {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static auto write(std::ostream& stream, std::span<const float> values) -> void {
+    stream.write(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+}
+
+template<typename T>
+static auto read(std::istream& stream) -> std::optional<T> {
+    auto value = T();
+    if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+static auto read(std::istream& stream, std::span<float> values) -> bool {
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(values.data()), values.size_bytes()));
+}
+
+};
+
+}
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <numbers>
 #include <random>
 #include <ranges>
+#include <span>
 
 namespace yam {
 
@@ -47,8 +52,107 @@ struct Random {
         });
     }
 
+    template<std::ranges::random_access_range Range>
+    void shuffle(Range&& range) {
+        std::ranges::shuffle(range, generator_);
+    }
+
 private:
     std::mt19937 generator_;
 };
 
-}
\ No newline at end of file
+// Counter based generator (Philox4x32-10): value i of a stream is a pure
+// function of seed, stream and i, so that ranges are filled in bulk, in any
+// order and by any number of threads with the same result.
+struct Philox {
+    using block_type = std::array<std::uint32_t, 4>;
+
+    Philox(std::uint64_t seed, std::uint64_t stream = 0) : 
+        key_ { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) },
+        stream_(stream)
+    { }
+
+    // four values of block with 64-bit index of the stream
+    auto operator()(std::uint64_t block) const -> block_type {
+        auto counter = block_type {
+            static_cast<std::uint32_t>(block),
+            static_cast<std::uint32_t>(block >> 32),
+            static_cast<std::uint32_t>(stream_),
+            static_cast<std::uint32_t>(stream_ >> 32)
+        };
+        auto key = key_;
+
+        for (auto round = 0; round < 10; ++round) {
+            const auto product0 = std::uint64_t(0xD2511F53u) * counter[0];
+            const auto product1 = std::uint64_t(0xCD9E8D57u) * counter[2];
+
+            counter = {
+                static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(product1),
+                static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(product0)
+            };
+
+            key[0] += 0x9E3779B9u;
+            key[1] += 0xBB67AE85u;
+        }
+        return counter;
+    }
+
+    // values [first, first + size) of the stream uniform in [min, max)
+    auto uniform(std::span<float> values, float min, float max, std::uint64_t first = 0) const -> void {
+        const auto scale = (max - min) * 0x1.0p-24f;
+        fill(values, first, [min, scale](const block_type& block, float* value) {
+            for (auto n = 0; n < 4; ++n) {
+                value[n] = min + (block[n] >> 8) * scale;
+            }
+        });
+    }
+
+    // values [first, first + size) of the stream normal with given mean and
+    // deviation, Box-Muller of block's pairs
+    auto normal(std::span<float> values, float mean, float deviation, std::uint64_t first = 0) const -> void {
+        fill(values, first, [mean, deviation](const block_type& block, float* value) {
+            for (auto n = 0; n < 4; n += 2) {
+                const auto u = 1.0f - (block[n] >> 8) * 0x1.0p-24f;
+                const auto v = (block[n + 1] >> 8) * 0x1.0p-24f;
+                const auto radius = deviation * std::sqrt(-2.0f * std::log(u));
+                const auto angle = 2.0f * std::numbers::pi_v<float> * v;
+
+                value[n] = mean + radius * std::cos(angle);
+                value[n + 1] = mean + radius * std::sin(angle);
+            }
+        });
+    }
+
+private:
+    // convert writes four values of a block, partial blocks at both ends
+    // go through a scratch
+    template<typename Convert>
+    auto fill(std::span<float> values, std::uint64_t first, Convert&& convert) const -> void {
+        auto scratch = std::array<float, 4>();
+        auto index = first;
+        auto value = values.begin().base();
+        const auto end = values.end().base();
+
+        while (value != end) {
+            const auto lane = index % 4;
+            const auto count = std::min<std::uint64_t>(4 - lane, end - value);
+
+            if (count == 4) {
+                convert((*this)(index / 4), value);
+            } else {
+                convert((*this)(index / 4), scratch.data());
+                std::copy_n(scratch.begin() + lane, count, value);
+            }
+
+            index += count;
+            value += count;
+        }
+    }
+
+    std::array<std::uint32_t, 2> key_;
+    std::uint64_t stream_;
+};
+
+}
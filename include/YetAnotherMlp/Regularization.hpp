@@ -0,0 +1,127 @@
+#pragma once
+
+#include "MLPerceptron.hpp"
+#include "Transform.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+// Normalization of hidden layers' weighted sums, scaled by gamma and shifted
+// by beta. Samples are trained one at a time, so the statistics are running
+// averages instead of batch ones and gradients treat them as constants.
+// Trained normalization is folded into weights and biases for inference.
+struct BatchNorm {
+    BatchNorm() = default;
+
+    BatchNorm(std::span<const int> topology, float momentum = 0.01f) : momentum(momentum) {
+        auto offset = 0;
+        for (const auto size : topology | std::views::drop(1) | std::views::take(topology.size() - 2)) {
+            offsets_.push_back(offset);
+            offset += size;
+        }
+
+        gamma.assign(offset, 1.0f);
+        beta.assign(offset, 0.0f);
+        mean.assign(offset, 0.0f);
+        variance.assign(offset, 1.0f);
+        normalized_.resize(offset);
+    }
+
+    float momentum = 0.01f;
+    float epsilon = 1e-5f;
+
+    // of every hidden neuron, layer after layer
+    std::vector<float> gamma;
+    std::vector<float> beta;
+    std::vector<float> mean;
+    std::vector<float> variance;
+
+    // weighted sums of hidden layer (1 is the first one) become its
+    // normalized, scaled and shifted ones, statistics are updated first
+    auto forward(int layer, std::span<float> sums) -> void {
+        const auto offset = offsets_[layer - 1];
+        for (auto n = 0u; n < sums.size(); ++n) {
+            const auto i = offset + n;
+            const auto delta = sums[n] - mean[i];
+            mean[i] += momentum * delta;
+            variance[i] = (1.0f - momentum) * (variance[i] + momentum * delta * delta);
+
+            normalized_[i] = (sums[n] - mean[i]) / std::sqrt(variance[i] + epsilon);
+            sums[n] = gamma[i] * normalized_[i] + beta[i];
+        }
+    }
+
+    // error of layer's normalized sums becomes the error of its weighted
+    // sums, gamma and beta are corrected as weights are
+    auto backward(int layer, std::span<float> error, float learnrate) -> void {
+        const auto offset = offsets_[layer - 1];
+        for (auto n = 0u; n < error.size(); ++n) {
+            const auto i = offset + n;
+            const auto scale = gamma[i] / std::sqrt(variance[i] + epsilon);
+
+            gamma[i] += learnrate * error[n] * normalized_[i];
+            beta[i] += learnrate * error[n];
+            error[n] *= scale;
+        }
+    }
+
+    // weights and biases of trained with the normalization folded in, into
+    // has trained's shape and biases
+    auto fold(const MLPerceptron& trained, MLPerceptron& into) const -> void {
+        std::ranges::copy(trained.weights(), into.weights().begin());
+        std::ranges::copy(trained.biases(), into.biases().begin());
+
+        const auto topology = trained.topology();
+        auto weight = into.weights().begin().base();
+        auto bias = into.biases().begin().base();
+
+        for (auto layer = 1u; layer + 1 < topology.size(); ++layer) {
+            const auto lc = topology[layer - 1];
+            const auto uc = topology[layer];
+            const auto offset = offsets_[layer - 1];
+
+            for (auto u = 0; u < uc; ++u, weight += lc) {
+                const auto i = offset + u;
+                const auto scale = gamma[i] / std::sqrt(variance[i] + epsilon);
+
+                std::ranges::transform(weight, weight + lc, weight, [scale](float w) { return w * scale; });
+                bias[u] = (bias[u] - mean[i]) * scale + beta[i];
+            }
+            bias += uc;
+        }
+    }
+
+private:
+    std::vector<int> offsets_;
+    std::vector<float> normalized_;
+};
+
+// Inverted dropout: kept neurons are scaled by 1 / (1 - rate), so that
+// inference runs the trained weights as they are.
+struct Dropout {
+    float rate = 0.0f;
+
+    // scales of neurons, 0 for dropped ones; every 64 random bits decide
+    // four neurons
+    auto mask(std::span<float> scales, std::uint64_t key) const -> void {
+        const auto threshold = static_cast<std::uint64_t>(rate * 65536.0f);
+        const auto kept = 1.0f / (1.0f - rate);
+
+        auto random = SampleRandom(key);
+        auto bits = std::uint64_t(0);
+        for (auto n = 0u; n < scales.size(); ++n, bits >>= 16) {
+            if (n % 4 == 0) {
+                bits = random();
+            }
+            scales[n] = (bits & 0xffff) >= threshold ? kept : 0.0f;
+        }
+    }
+};
+
+}
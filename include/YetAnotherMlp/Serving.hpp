@@ -0,0 +1,211 @@
+#pragma once
+
+#include "MLPerceptron.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace yam {
+
+// Lock free histogram of latencies in nanoseconds, buckets are logarithmic
+// with 8 sub-buckets per power of two, so percentiles are within 12.5%.
+struct LatencyHistogram {
+    auto record(std::chrono::nanoseconds latency) -> void {
+        const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0));
+        buckets_[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto count() const -> std::uint64_t { return count_.load(std::memory_order_relaxed); }
+
+    // upper bound of the bucket holding the p-th quantile, p in [0, 1]
+    auto percentile(double p) const -> std::chrono::nanoseconds {
+        const auto total = count();
+        if (total == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+
+        const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(p * total + 0.5));
+        auto seen = std::uint64_t(0);
+        for (auto b = 0u; b < buckets_.size(); ++b) {
+            seen += buckets_[b].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(upperBound(b));
+            }
+        }
+        return std::chrono::nanoseconds(upperBound(buckets_.size() - 1));
+    }
+
+    auto reset() -> void {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr auto subBuckets = 8u;
+
+    static auto bucket(std::uint64_t ns) -> unsigned {
+        if (ns < subBuckets) {
+            return ns;
+        }
+        const auto exponent = std::bit_width(ns) - 1u;
+        const auto sub = (ns >> (exponent - 3)) & (subBuckets - 1);
+        return (exponent - 2) * subBuckets + sub;
+    }
+
+    static auto upperBound(unsigned bucket) -> std::uint64_t {
+        if (bucket < subBuckets) {
+            return bucket;
+        }
+        const auto exponent = bucket / subBuckets + 2;
+        const auto sub = bucket % subBuckets;
+        return ((subBuckets + sub + 1) << (exponent - 3)) - 1;
+    }
+
+    std::array<std::atomic<std::uint64_t>, 62 * subBuckets> buckets_ = {};
+    std::atomic<std::uint64_t> count_ = 0;
+};
+
+struct BatcherOptions {
+    // a batch is run once it has maxBatch requests or its oldest request
+    // waited maxDelay, whichever comes first
+    int maxBatch = 32;
+    std::chrono::microseconds maxDelay = std::chrono::microseconds(200);
+
+    // workers running batches, each on its own copy of the perceptron
+    int threads = 1;
+};
+
+// Dynamic micro-batching of concurrent predictions: callers block in predict
+// while workers collect their requests into batches.
+struct Batcher {
+    using Options = BatcherOptions;
+
+    Batcher(
+        const MLPerceptron& mlp,
+        Options options = {}
+    ) : options_(options)
+    {
+        options_.maxBatch = std::max(options_.maxBatch, 1);
+        for (auto t = 0; t < std::max(options_.threads, 1); ++t) {
+            workers_.emplace_back([this, mlp] () mutable { run(std::move(mlp)); });
+        }
+    }
+
+    Batcher(const Batcher&) = delete;
+    auto operator=(const Batcher&) -> Batcher& = delete;
+
+    ~Batcher() {
+        {
+            const auto lock = std::lock_guard(mutex_);
+            stop_ = true;
+        }
+        arrived_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // outputs for input, latency from submission to completion is recorded
+    auto predict(std::span<const float> input) -> std::vector<float> {
+        auto request = Request {
+            .input = input,
+            .arrival = std::chrono::steady_clock::now()
+        };
+
+        {
+            auto lock = std::unique_lock(mutex_);
+            queue_.push_back(&request);
+            arrived_.notify_one();
+            completed_.wait(lock, [&] { return request.done; });
+        }
+
+        latencies_.record(std::chrono::steady_clock::now() - request.arrival);
+        return std::move(request.output);
+    }
+
+    auto latencies() const -> const LatencyHistogram& { return latencies_; }
+    auto latencies()       ->       LatencyHistogram& { return latencies_; }
+
+    auto batches() const -> std::uint64_t { return batches_.load(std::memory_order_relaxed); }
+    auto requests() const -> std::uint64_t { return requests_.load(std::memory_order_relaxed); }
+
+private:
+    struct Request {
+        std::span<const float> input;
+        std::chrono::steady_clock::time_point arrival;
+        std::vector<float> output = {};
+        bool done = false;
+    };
+
+    auto run(MLPerceptron mlp) -> void {
+        auto batch = std::vector<Request*>();
+
+        while (true) {
+            {
+                auto lock = std::unique_lock(mutex_);
+                arrived_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (stop_) {
+                    return;
+                }
+
+                const auto deadline = queue_.front()->arrival + options_.maxDelay;
+                arrived_.wait_until(lock, deadline, [this] {
+                    return stop_ || queue_.size() >= static_cast<std::size_t>(options_.maxBatch);
+                });
+
+                // another worker may have taken the requests meanwhile
+                const auto size = std::min<std::size_t>(queue_.size(), options_.maxBatch);
+                batch.assign(queue_.begin(), queue_.begin() + size);
+                queue_.erase(queue_.begin(), queue_.begin() + size);
+            }
+
+            if (batch.empty()) {
+                continue;
+            }
+
+            for (const auto request : batch) {
+                const auto output = mlp.forward(request->input.data());
+                request->output.assign(output.begin(), output.end());
+            }
+
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            requests_.fetch_add(batch.size(), std::memory_order_relaxed);
+
+            {
+                const auto lock = std::lock_guard(mutex_);
+                for (const auto request : batch) {
+                    request->done = true;
+                }
+            }
+            completed_.notify_all();
+        }
+    }
+
+    Options options_;
+    LatencyHistogram latencies_;
+    std::atomic<std::uint64_t> batches_ = 0;
+    std::atomic<std::uint64_t> requests_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable arrived_;
+    std::condition_variable completed_;
+    std::deque<Request*> queue_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+}
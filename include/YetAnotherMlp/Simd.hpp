@@ -0,0 +1,355 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+namespace yam {
+
+// instruction sets kernels are built for, in order of preference
+enum class Isa {
+    Scalar, // plain loops, the reference of the others
+    Sse4,
+    Avx2,   // with fma
+    Avx512
+};
+
+// one build of every vectorized kernel
+struct SimdKernels {
+    Isa isa;
+
+    // sum of a[i] * b[i]
+    float (*dot)(const float* a, const float* b, int size);
+
+    // sum of (a[i] - b[i])^2
+    float (*distance)(const float* a, const float* b, int size);
+
+    // y[i] += a * x[i]
+    void (*axpy)(float a, const float* x, float* y, int size);
+
+    // y[i] *= x[i]
+    void (*multiply)(const float* x, float* y, int size);
+
+    // product = transposed(matrix) * vector for row-major matrix of rows x cols
+    void (*transposedMatmul)(const float* matrix, const float* vector, float* product, int rows, int cols);
+};
+
+#if defined(__GNUC__)
+// W floats in a vector register, sizes are spelled out as GCC drops
+// dependent vector sizes of templates
+template<int W>
+struct SimdVector;
+
+template<> struct SimdVector<4>  { typedef float type __attribute__((vector_size(16))); };
+template<> struct SimdVector<8>  { typedef float type __attribute__((vector_size(32))); };
+template<> struct SimdVector<16> { typedef float type __attribute__((vector_size(64))); };
+#endif
+
+// Kernels written once over W lanes of GCC/Clang vector extensions. They are
+// always inlined into per-ISA entry points compiled with target attributes,
+// so each instruction set gets its own build within one binary.
+#if defined(__GNUC__)
+// load returns vectors by value, but is always inlined, so no ABI applies
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+template<int W>
+struct SimdLanes {
+#if defined(__GNUC__)
+    using Vector = typename SimdVector<W>::type;
+
+    [[gnu::always_inline]] static inline auto load(const float* p) -> Vector {
+        auto v = Vector();
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    [[gnu::always_inline]] static inline auto store(float* p, const Vector& v) -> void {
+        std::memcpy(p, &v, sizeof(v));
+    }
+
+    [[gnu::always_inline]] static inline auto sum(const Vector& v) -> float {
+        auto result = 0.0f;
+        for (auto k = 0; k < W; ++k) {
+            result += v[k];
+        }
+        return result;
+    }
+
+    // two accumulators hide the latency of additions
+    [[gnu::always_inline]] static inline auto dot(const float* a, const float* b, int size) -> float {
+        auto s0 = Vector();
+        auto s1 = Vector();
+        auto i = 0;
+        for (; i + 2 * W <= size; i += 2 * W) {
+            s0 += load(a + i) * load(b + i);
+            s1 += load(a + i + W) * load(b + i + W);
+        }
+        for (; i + W <= size; i += W) {
+            s0 += load(a + i) * load(b + i);
+        }
+
+        auto result = sum(s0 + s1);
+        for (; i < size; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    [[gnu::always_inline]] static inline auto distance(const float* a, const float* b, int size) -> float {
+        auto s0 = Vector();
+        auto s1 = Vector();
+        auto i = 0;
+        for (; i + 2 * W <= size; i += 2 * W) {
+            const auto d0 = load(a + i) - load(b + i);
+            const auto d1 = load(a + i + W) - load(b + i + W);
+            s0 += d0 * d0;
+            s1 += d1 * d1;
+        }
+        for (; i + W <= size; i += W) {
+            const auto d = load(a + i) - load(b + i);
+            s0 += d * d;
+        }
+
+        auto result = sum(s0 + s1);
+        for (; i < size; ++i) {
+            result += (a[i] - b[i]) * (a[i] - b[i]);
+        }
+        return result;
+    }
+
+    [[gnu::always_inline]] static inline auto axpy(float a, const float* x, float* y, int size) -> void {
+        const auto va = Vector() + a;
+        auto i = 0;
+        for (; i + W <= size; i += W) {
+            store(y + i, load(y + i) + va * load(x + i));
+        }
+        for (; i < size; ++i) {
+            y[i] += a * x[i];
+        }
+    }
+
+    [[gnu::always_inline]] static inline auto multiply(const float* x, float* y, int size) -> void {
+        auto i = 0;
+        for (; i + W <= size; i += W) {
+            store(y + i, load(y + i) * load(x + i));
+        }
+        for (; i < size; ++i) {
+            y[i] *= x[i];
+        }
+    }
+
+    // rows are added four at a time so that every element of product is
+    // loaded and stored once per four rows
+    [[gnu::always_inline]] static inline auto transposedMatmul(
+        const float* matrix,
+        const float* vector,
+        float* product,
+        int rows,
+        int cols
+    ) -> void {
+        std::fill(product, product + cols, 0.0f);
+
+        auto r = 0;
+        for (; r + 4 <= rows; r += 4, matrix += 4 * cols) {
+            const auto v0 = Vector() + vector[r];
+            const auto v1 = Vector() + vector[r + 1];
+            const auto v2 = Vector() + vector[r + 2];
+            const auto v3 = Vector() + vector[r + 3];
+            const auto m0 = matrix;
+            const auto m1 = matrix + cols;
+            const auto m2 = matrix + 2 * cols;
+            const auto m3 = matrix + 3 * cols;
+
+            auto c = 0;
+            for (; c + W <= cols; c += W) {
+                store(product + c, load(product + c)
+                    + load(m0 + c) * v0 + load(m1 + c) * v1
+                    + load(m2 + c) * v2 + load(m3 + c) * v3);
+            }
+            for (; c < cols; ++c) {
+                product[c] += m0[c] * vector[r] + m1[c] * vector[r + 1]
+                            + m2[c] * vector[r + 2] + m3[c] * vector[r + 3];
+            }
+        }
+
+        for (; r < rows; ++r, matrix += cols) {
+            axpy(vector[r], matrix, product, cols);
+        }
+    }
+#endif
+};
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// Vectorized kernels of the best instruction set the CPU supports, chosen at
+// runtime once; builds of other instruction sets stay available, e.g. for
+// tests against the scalar reference.
+struct Simd {
+
+struct Scalar {
+    static auto dot(const float* a, const float* b, int size) -> float {
+        auto sum = 0.0f;
+        for (auto i = 0; i < size; ++i) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static auto distance(const float* a, const float* b, int size) -> float {
+        auto sum = 0.0f;
+        for (auto i = 0; i < size; ++i) {
+            sum += (a[i] - b[i]) * (a[i] - b[i]);
+        }
+        return sum;
+    }
+
+    static auto axpy(float a, const float* x, float* y, int size) -> void {
+        for (auto i = 0; i < size; ++i) {
+            y[i] += a * x[i];
+        }
+    }
+
+    static auto multiply(const float* x, float* y, int size) -> void {
+        for (auto i = 0; i < size; ++i) {
+            y[i] *= x[i];
+        }
+    }
+
+    static auto transposedMatmul(const float* matrix, const float* vector, float* product, int rows, int cols) -> void {
+        std::fill(product, product + cols, 0.0f);
+        for (auto r = 0; r < rows; ++r, matrix += cols) {
+            axpy(vector[r], matrix, product, cols);
+        }
+    }
+};
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YAM_SIMD_X86 1
+
+struct Sse4 {
+    using Lanes = SimdLanes<4>;
+
+    [[gnu::target("sse4.2")]] static auto dot(const float* a, const float* b, int size) -> float { return Lanes::dot(a, b, size); }
+    [[gnu::target("sse4.2")]] static auto distance(const float* a, const float* b, int size) -> float { return Lanes::distance(a, b, size); }
+    [[gnu::target("sse4.2")]] static auto axpy(float a, const float* x, float* y, int size) -> void { Lanes::axpy(a, x, y, size); }
+    [[gnu::target("sse4.2")]] static auto multiply(const float* x, float* y, int size) -> void { Lanes::multiply(x, y, size); }
+    [[gnu::target("sse4.2")]] static auto transposedMatmul(const float* matrix, const float* vector, float* product, int rows, int cols) -> void {
+        Lanes::transposedMatmul(matrix, vector, product, rows, cols);
+    }
+};
+
+struct Avx2 {
+    using Lanes = SimdLanes<8>;
+
+    [[gnu::target("avx2,fma")]] static auto dot(const float* a, const float* b, int size) -> float { return Lanes::dot(a, b, size); }
+    [[gnu::target("avx2,fma")]] static auto distance(const float* a, const float* b, int size) -> float { return Lanes::distance(a, b, size); }
+    [[gnu::target("avx2,fma")]] static auto axpy(float a, const float* x, float* y, int size) -> void { Lanes::axpy(a, x, y, size); }
+    [[gnu::target("avx2,fma")]] static auto multiply(const float* x, float* y, int size) -> void { Lanes::multiply(x, y, size); }
+    [[gnu::target("avx2,fma")]] static auto transposedMatmul(const float* matrix, const float* vector, float* product, int rows, int cols) -> void {
+        Lanes::transposedMatmul(matrix, vector, product, rows, cols);
+    }
+};
+
+struct Avx512 {
+    using Lanes = SimdLanes<16>;
+
+    [[gnu::target("avx512f")]] static auto dot(const float* a, const float* b, int size) -> float { return Lanes::dot(a, b, size); }
+    [[gnu::target("avx512f")]] static auto distance(const float* a, const float* b, int size) -> float { return Lanes::distance(a, b, size); }
+    [[gnu::target("avx512f")]] static auto axpy(float a, const float* x, float* y, int size) -> void { Lanes::axpy(a, x, y, size); }
+    [[gnu::target("avx512f")]] static auto multiply(const float* x, float* y, int size) -> void { Lanes::multiply(x, y, size); }
+    [[gnu::target("avx512f")]] static auto transposedMatmul(const float* matrix, const float* vector, float* product, int rows, int cols) -> void {
+        Lanes::transposedMatmul(matrix, vector, product, rows, cols);
+    }
+};
+
+#endif
+
+static auto supported(Isa isa) -> bool {
+    switch (isa) {
+        case Isa::Scalar: return true;
+#if defined(YAM_SIMD_X86)
+        case Isa::Sse4: return __builtin_cpu_supports("sse4.2");
+        case Isa::Avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case Isa::Avx512: return __builtin_cpu_supports("avx512f");
+#endif
+        default: return false;
+    }
+}
+
+static auto best() -> Isa {
+    for (const auto isa : {Isa::Avx512, Isa::Avx2, Isa::Sse4}) {
+        if (supported(isa)) {
+            return isa;
+        }
+    }
+    return Isa::Scalar;
+}
+
+// build of isa, the scalar one when isa is not built for this platform;
+// calling it on a CPU without isa is undefined
+static auto kernels(Isa isa) -> const SimdKernels& {
+    static const auto builds = std::array {
+        build<Scalar>(Isa::Scalar),
+#if defined(YAM_SIMD_X86)
+        build<Sse4>(Isa::Sse4),
+        build<Avx2>(Isa::Avx2),
+        build<Avx512>(Isa::Avx512),
+#endif
+    };
+
+    const auto found = std::ranges::find(builds, isa, &SimdKernels::isa);
+    return found != builds.end() ? *found : builds.front();
+}
+
+// kernels used by the library, of best() unless selected otherwise
+static auto active() -> const SimdKernels& {
+    return *selected().load(std::memory_order_relaxed);
+}
+
+// uses isa from now on, false when the CPU does not support it
+static auto select(Isa isa) -> bool {
+    if (!supported(isa)) {
+        return false;
+    }
+    selected().store(&kernels(isa), std::memory_order_relaxed);
+    return true;
+}
+
+static auto dot(const float* a, const float* b, int size) -> float { return active().dot(a, b, size); }
+static auto distance(const float* a, const float* b, int size) -> float { return active().distance(a, b, size); }
+static auto axpy(float a, const float* x, float* y, int size) -> void { active().axpy(a, x, y, size); }
+static auto multiply(const float* x, float* y, int size) -> void { active().multiply(x, y, size); }
+
+static auto transposedMatmul(const float* matrix, const float* vector, float* product, int rows, int cols) -> void {
+    active().transposedMatmul(matrix, vector, product, rows, cols);
+}
+
+private:
+
+template<typename Build>
+static constexpr auto build(Isa isa) -> SimdKernels {
+    return {
+        .isa = isa,
+        .dot = &Build::dot,
+        .distance = &Build::distance,
+        .axpy = &Build::axpy,
+        .multiply = &Build::multiply,
+        .transposedMatmul = &Build::transposedMatmul
+    };
+}
+
+static auto selected() -> std::atomic<const SimdKernels*>& {
+    static auto kernels = std::atomic<const SimdKernels*>(&Simd::kernels(best()));
+    return kernels;
+}
+
+};
+
+#undef YAM_SIMD_X86
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "MLPerceptron.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+// compressed sparse row matrix, a row holds weights of one upper neuron
+struct CsrMatrix {
+    CsrMatrix() : CsrMatrix({}, 0, 0) { }
+
+    CsrMatrix(
+        std::span<const float> dense,
+        int rows,
+        int columns
+    ) : rows_(rows),
+        columns_(columns),
+        offsets_(rows + 1)
+    {
+        for (auto r = 0; r < rows; ++r) {
+            for (auto c = 0; c < columns; ++c) {
+                if (const auto value = dense[r * columns + c]; value != 0) {
+                    indices_.push_back(c);
+                    values_.push_back(value);
+                }
+            }
+            offsets_[r + 1] = values_.size();
+        }
+    }
+
+    auto rows() const -> int { return rows_; }
+    auto columns() const -> int { return columns_; }
+    auto nonzeros() const -> int { return values_.size(); }
+
+    auto bytes() const -> std::size_t {
+        return offsets_.size() * sizeof(int) 
+            + indices_.size() * sizeof(int) 
+            + values_.size() * sizeof(float);
+    }
+
+    auto multiply(const float* vector, float* result) const -> float* {
+        auto index = indices_.begin().base();
+        auto value = values_.begin().base();
+
+        for (auto r = 0; r < rows_; ++r) {
+            const auto last = values_.begin().base() + offsets_[r + 1];
+
+            auto sum = 0.0f;
+            for (; value != last; ++value, ++index) {
+                sum += *value * vector[*index];
+            }
+            *result++ = sum;
+        }
+
+        return result;
+    }
+
+    // vectors and result are row-major, one vector / result per row
+    auto multiply(const float* vectors, int count, float* result) const -> float* {
+        for (auto r = 0; r < rows_; ++r) {
+            const auto first = offsets_[r];
+            const auto last = offsets_[r + 1];
+
+            for (auto v = 0; v < count; ++v) {
+                const auto vector = vectors + v * columns_;
+
+                auto sum = 0.0f;
+                for (auto i = first; i < last; ++i) {
+                    sum += values_[i] * vector[indices_[i]];
+                }
+                result[v * rows_ + r] = sum;
+            }
+        }
+
+        return result + count * rows_;
+    }
+
+private:
+    int rows_;
+    int columns_;
+    std::vector<int> offsets_;
+    std::vector<int> indices_;
+    std::vector<float> values_;
+};
+
+// zeroes weights with magnitude below threshold, returns number of zeroed weights
+inline auto prune(MLPerceptron& mlp, float threshold) -> int {
+    auto pruned = 0;
+    for (auto& weight : mlp.weights()) {
+        if (std::fabs(weight) < threshold) {
+            pruned += weight != 0;
+            weight = 0;
+        }
+    }
+    return pruned;
+}
+
+// zeroes smallest weights of every layer so that given fraction of each layer is zero
+inline auto pruneFraction(MLPerceptron& mlp, float sparsity) -> void {
+    auto weight = mlp.weights().begin();
+    auto magnitudes = std::vector<float>();
+
+    for (const auto [lc, uc] : std::views::adjacent<2>(mlp.topology())) {
+        const auto layer = std::span(weight, weight + lc * uc);
+        const auto zeroes = static_cast<std::ptrdiff_t>(sparsity * layer.size());
+        weight += layer.size();
+
+        if (zeroes <= 0) {
+            continue;
+        }
+
+        magnitudes.resize(layer.size());
+        std::ranges::transform(layer, magnitudes.begin(), [](auto w) { return std::fabs(w); });
+        std::ranges::nth_element(magnitudes, magnitudes.begin() + zeroes - 1);
+
+        const auto threshold = magnitudes[zeroes - 1];
+        auto left = zeroes;
+
+        for (auto& w : layer) {
+            if (left && std::fabs(w) <= threshold) {
+                w = 0;
+                --left;
+            }
+        }
+    }
+}
+
+// inference only copy of a (pruned) perceptron with weights in CSR format
+struct SparseMLPerceptron {
+    SparseMLPerceptron() : SparseMLPerceptron(MLPerceptron()) { }
+
+    SparseMLPerceptron(const MLPerceptron& dense) 
+    : topology_(dense.topology().begin(), dense.topology().end()),
+      neurons_(dense.neurons().size()),
+      biases_(dense.biases().begin(), dense.biases().end())
+    {
+        auto weight = dense.weights().begin();
+        auto layer = 0;
+
+        for (const auto [lc, uc] : std::views::adjacent<2>(topology_)) {
+            layers_.emplace_back(std::span(weight, weight + lc * uc), uc, lc);
+            activations_.push_back(dense.activation(layer++));
+            weight += lc * uc;
+        }
+    }
+
+    auto forward(const float* input) -> std::span<const float> {
+        return forward(input, 1);
+    }
+
+    // inputs are row-major, returns count rows of outputs
+    auto forward(const float* inputs, int count) -> std::span<const float> {
+        const auto neurons = count * yam::sum(topology_ | std::views::drop(1));
+        if (neurons_.size() < neurons) {
+            neurons_.resize(neurons);
+        }
+
+        auto lower = inputs;
+        auto upper = neurons_.begin().base();
+        auto bias = biases_.begin().base();
+        auto activation = activations_.begin();
+
+        for (const auto& layer : layers_) {
+            const auto uc = layer.rows();
+            const auto last = layer.multiply(lower, count, upper);
+
+            for (auto u = bias ? 0 : uc; u < uc; ++u) {
+                for (auto v = 0; v < count; ++v) {
+                    upper[v * uc + u] += bias[u];
+                }
+            }
+            bias += bias ? uc : 0;
+
+            lower = upper;
+            upper = (*activation++)({upper, last}, upper);
+        }
+
+        return {lower, upper};
+    }
+
+    auto topology() const -> std::span<const int> { return topology_; }
+    auto layers() const -> std::span<const CsrMatrix> { return layers_; }
+
+    auto nonzeros() const -> int {
+        return yam::sum(layers_ | std::views::transform(&CsrMatrix::nonzeros));
+    }
+
+    auto sparsity() const -> float {
+        const auto weights = yam::sum(layers_ | std::views::transform([](auto&& l) { 
+            return l.rows() * l.columns(); 
+        }));
+        return weights ? 1 - float(nonzeros()) / weights : 0;
+    }
+
+    auto bytes() const -> std::size_t {
+        return yam::sum(layers_ | std::views::transform(&CsrMatrix::bytes)) 
+            + biases_.size() * sizeof(float);
+    }
+
+private:
+    std::vector<int> topology_;
+    std::vector<CsrMatrix> layers_;
+    std::vector<float> neurons_;
+    std::vector<float> biases_;
+    std::vector<MLPerceptron::activation_function> activations_;
+};
+
+}
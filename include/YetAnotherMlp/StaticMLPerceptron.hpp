@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Activation.hpp"
+#include "MLPerceptron.hpp"
+
+#include <array>
+#include <concepts>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace yam {
+
+// Perceptron with topology known at compile time. Weights, biases and neurons
+// live in std::arrays (big models belong in static or heap storage of the
+// caller), every loop has a constant trip count and activations are inlined
+// functors, e.g. Activation::Sigmoid, or a std::tuple with one functor per layer.
+// Weights layout is the same as in MLPerceptron, so they can be loaded from it.
+template<typename Activations, bool Bias, int... Topology>
+requires (sizeof...(Topology) >= 2 && ((Topology > 0) && ...))
+struct StaticMLPerceptron {
+    static constexpr auto topology = std::array { Topology... };
+    static constexpr auto layers = topology.size() - 1;
+
+    static constexpr auto inputs = topology.front();
+    static constexpr auto outputs = topology.back();
+
+    static constexpr auto neuronCount = (Topology + ...) - inputs;
+    static constexpr auto weightCount = [] {
+        auto sum = 0;
+        for (auto l = 0u; l < layers; ++l) {
+            sum += topology[l] * topology[l + 1];
+        }
+        return sum;
+    }();
+
+    auto forward(const float* input) -> std::span<const float, outputs> {
+        forward(input, std::make_index_sequence<layers>());
+        return std::span<const float, outputs>(neurons_.end() - outputs, outputs);
+    }
+
+    // copies weights of a perceptron with the same topology and bias
+    auto load(const MLPerceptron& mlp) -> bool {
+        if (!std::ranges::equal(mlp.topology(), topology) || mlp.biases().size() != biases_.size()) {
+            return false;
+        }
+
+        std::ranges::copy(mlp.weights(), weights_.begin());
+        std::ranges::copy(mlp.biases(), biases_.begin());
+        return true;
+    }
+
+    auto neurons() const -> std::span<const float, neuronCount> { return neurons_; }
+
+    auto weights() const -> std::span<const float, weightCount> { return weights_; }
+    auto weights()       -> std::span<      float, weightCount> { return weights_; }
+
+    auto biases() const -> std::span<const float> { return biases_; }
+    auto biases()       -> std::span<      float> { return biases_; }
+
+private:
+    // independent partial sums let the compiler vectorize dot products
+    static constexpr auto lanes = 8;
+
+    template<std::size_t L>
+    static constexpr auto offsets() {
+        auto weight = 0;
+        auto neuron = 0;
+        for (auto l = 0u; l < L; ++l) {
+            weight += topology[l] * topology[l + 1];
+            neuron += topology[l + 1];
+        }
+        return std::make_pair(weight, neuron);
+    }
+
+    template<std::size_t L>
+    static auto activation() {
+        if constexpr (requires { std::tuple_size<Activations>::value; }) {
+            return std::tuple_element_t<L, Activations>();
+        } else {
+            return Activations();
+        }
+    }
+
+    template<std::size_t... L>
+    auto forward(const float* input, std::index_sequence<L...>) -> void {
+        (layer<L>(input), ...);
+    }
+
+    template<std::size_t L>
+    auto layer(const float* input) -> void {
+        constexpr auto lc = topology[L];
+        constexpr auto uc = topology[L + 1];
+        constexpr auto offset = offsets<L>();
+        constexpr auto lower = int(offsets<L - (L > 0)>().second);
+
+        const auto signal = L == 0 ? input : neurons_.data() + lower;
+        const auto weight = weights_.data() + offset.first;
+        const auto upper = neurons_.data() + offset.second;
+        const auto activate = activation<L>();
+
+        for (auto u = 0; u < uc; ++u) {
+            const auto row = weight + u * lc;
+
+            auto partial = std::array<float, lanes>();
+            auto l = 0;
+            for (; l + lanes <= lc; l += lanes) {
+                for (auto k = 0; k < lanes; ++k) {
+                    partial[k] += row[l + k] * signal[l + k];
+                }
+            }
+
+            auto sum = 0.0f;
+            for (; l < lc; ++l) {
+                sum += row[l] * signal[l];
+            }
+            for (const auto p : partial) {
+                sum += p;
+            }
+
+            if constexpr (Bias) {
+                sum += biases_[offset.second + u];
+            }
+
+            upper[u] = activate(sum);
+        }
+    }
+
+    std::array<float, weightCount> weights_ = {};
+    std::array<float, Bias ? neuronCount : 0> biases_ = {};
+    std::array<float, neuronCount> neurons_ = {};
+};
+
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace yam {
+
+// Work stealing task scheduler. Every worker owns a queue, pops its own
+// newest tasks and steals the oldest ones of other workers when it runs dry.
+// A thread waiting for its parallelFor executes the remaining tasks of that
+// call only, so nested parallel calls from inside of tasks neither deadlock
+// nor run foreign tasks on top of the waiting one (which would clobber its
+// per worker state).
+struct ThreadPool {
+    ThreadPool() : ThreadPool(std::thread::hardware_concurrency()) { }
+
+    // workers are pinned to cores[i % cores.size()] when cores are given,
+    // pass cores of a single node to keep the pool NUMA local
+    ThreadPool(
+        int threads,
+        std::vector<int> cores = {}
+    ) : queues_(std::max(threads, 1))
+    {
+        for (auto i = 0; i < queues_.size(); ++i) {
+            const auto core = cores.empty() ? -1 : cores[i % cores.size()];
+            workers_.emplace_back([this, i, core] { run(i, core); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+    ~ThreadPool() {
+        {
+            const auto lock = std::lock_guard(sleep_);
+            stop_ = true;
+        }
+        wakeup_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    auto size() const -> int { return workers_.size(); }
+
+    // index of the calling worker, size() for threads outside of the pool
+    auto index() const -> int {
+        return current_.pool == this ? current_.index : size();
+    }
+
+    // calls body(first, last) for consecutive chunks of at most grain indexes
+    template<typename Body>
+    void parallelFor(int first, int last, int grain, Body&& body) {
+        grain = std::max(grain, 1);
+
+        const auto chunks = (last - first + grain - 1) / grain;
+        if (chunks <= 1) {
+            if (first < last) {
+                body(first, last);
+            }
+            return;
+        }
+
+        auto pending = std::atomic<int>(chunks - 1);
+        const auto call = [](void* body, int first, int last) {
+            (*static_cast<std::remove_reference_t<Body>*>(body))(first, last);
+        };
+
+        const auto self = index();
+        for (auto c = 1; c < chunks; ++c) {
+            const auto task = Task {
+                .call = call,
+                .body = std::addressof(body),
+                .first = first + c * grain,
+                .last = std::min(last, first + (c + 1) * grain),
+                .pending = &pending
+            };
+
+            queued_.fetch_add(1, std::memory_order_release);
+            if (!queues_[(self + c) % queues_.size()].push(task)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                execute(task);
+            }
+        }
+
+        {
+            const auto lock = std::lock_guard(sleep_);
+        }
+        wakeup_.notify_all();
+
+        body(first, std::min(last, first + grain));
+
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (!help(self, &pending)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // chunks are mapped in parallel and reduced in order, so the result does
+    // not depend on the number of workers, only on the grain
+    template<typename T, typename Map, typename Reduce>
+    auto parallelReduce(
+        int first,
+        int last,
+        int grain,
+        T init,
+        Map&& map,
+        Reduce&& reduce
+    ) -> T {
+        grain = std::max(grain, 1);
+
+        auto partials = std::vector<T>(std::max((last - first + grain - 1) / grain, 0));
+
+        parallelFor(0, partials.size(), 1, [&](int cf, int cl) {
+            for (auto c = cf; c < cl; ++c) {
+                partials[c] = map(first + c * grain, std::min(last, first + (c + 1) * grain));
+            }
+        });
+
+        return std::ranges::fold_left(partials, init, reduce);
+    }
+
+private:
+    struct Task {
+        void (*call)(void*, int, int);
+        void* body;
+        int first;
+        int last;
+        std::atomic<int>* pending;
+    };
+
+    // bounded ring, owner takes from the back, thieves from the front
+    struct Queue {
+        static constexpr auto capacity = 1024u;
+
+        auto push(const Task& task) -> bool {
+            const auto lock = std::lock_guard(mutex);
+            if (tail - head == capacity) {
+                return false;
+            }
+            tasks[tail++ % capacity] = task;
+            return true;
+        }
+
+        auto pop() -> std::optional<Task> {
+            const auto lock = std::lock_guard(mutex);
+            if (head == tail) {
+                return std::nullopt;
+            }
+            return tasks[--tail % capacity];
+        }
+
+        auto steal() -> std::optional<Task> {
+            const auto lock = std::lock_guard(mutex);
+            if (head == tail) {
+                return std::nullopt;
+            }
+            return tasks[head++ % capacity];
+        }
+
+        // takes any task of the given call, the newest task fills its place
+        auto take(const std::atomic<int>* pending) -> std::optional<Task> {
+            const auto lock = std::lock_guard(mutex);
+            for (auto i = tail; i != head; --i) {
+                auto& task = tasks[(i - 1) % capacity];
+                if (task.pending == pending) {
+                    const auto taken = task;
+                    task = tasks[--tail % capacity];
+                    return taken;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::mutex mutex;
+        std::vector<Task> tasks = std::vector<Task>(capacity);
+        std::size_t head = 0;
+        std::size_t tail = 0;
+    };
+
+    // zero initialized as every thread_local
+    struct Current {
+        const ThreadPool* pool;
+        int index;
+    };
+
+    static auto execute(const Task& task) -> void {
+        task.call(task.body, task.first, task.last);
+        task.pending->fetch_sub(1, std::memory_order_release);
+    }
+
+    // runs one queued task, own queue first, returns false when there was none,
+    // only tasks of the given call are run when pending is given
+    auto help(int self, const std::atomic<int>* pending = nullptr) -> bool {
+        const auto size = static_cast<int>(queues_.size());
+        const auto take = [pending](Queue& queue, bool own) {
+            return pending ? queue.take(pending) : own ? queue.pop() : queue.steal();
+        };
+
+        auto task = self < size ? take(queues_[self], true) : std::nullopt;
+        for (auto v = 1; !task && v <= size; ++v) {
+            task = take(queues_[(self + v) % size], false);
+        }
+
+        if (!task) {
+            return false;
+        }
+
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        execute(*task);
+        return true;
+    }
+
+    auto run(int index, int core) -> void {
+        current_ = Current { .pool = this, .index = index };
+
+        if (core >= 0) {
+            pin(core);
+        }
+
+        while (true) {
+            if (help(index)) {
+                continue;
+            }
+
+            auto lock = std::unique_lock(sleep_);
+            wakeup_.wait(lock, [this] {
+                return stop_ || queued_.load(std::memory_order_acquire) > 0;
+            });
+
+            if (stop_) {
+                return;
+            }
+        }
+    }
+
+    static auto pin(int core) -> bool {
+#if defined(__linux__)
+        auto set = cpu_set_t();
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    std::vector<Queue> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<int> queued_ = 0;
+    std::mutex sleep_;
+    std::condition_variable wakeup_;
+    bool stop_ = false;
+
+    inline static thread_local Current current_;
+};
+
+// One lazily constructed copy of T per worker and one for threads outside of
+// the pool. A copy is made by the thread that uses it first, so its memory is
+// first touched on that thread's NUMA node.
+template<typename T>
+struct PerWorker {
+    PerWorker(
+        const ThreadPool& pool,
+        T prototype = T()
+    ) : pool_(std::addressof(pool)),
+        prototype_(std::move(prototype)),
+        items_(pool.size() + 1)
+    {
+
+    }
+
+    auto local() -> T& {
+        auto& item = items_[pool_->index()];
+        if (!item) {
+            item.emplace(prototype_);
+        }
+        return *item;
+    }
+
+    auto prototype() const -> const T& { return prototype_; }
+
+    // copies already made by workers
+    auto items() {
+        return items_
+        | std::views::filter([](auto&& i) { return i.has_value(); })
+        | std::views::transform([](auto&& i) -> T& { return *i; });
+    }
+
+private:
+    const ThreadPool* pool_;
+    T prototype_;
+    std::vector<std::optional<T>> items_;
+};
+
+}
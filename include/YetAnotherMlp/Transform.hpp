@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Dataset.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+// Cheap generator seeded per sample (splitmix64), so augmentation of
+// a sample does not depend on which thread transforms it or in what order.
+struct SampleRandom {
+    SampleRandom(std::uint64_t key) : state_(key) { }
+
+    auto operator()() -> std::uint64_t {
+        auto z = (state_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0, 1)
+    auto uniform() -> float {
+        return ((*this)() >> 40) * 0x1.0p-24f;
+    }
+
+    // uniform in [min, max]
+    auto operator()(int min, int max) -> int {
+        return min + static_cast<int>((*this)() % static_cast<std::uint64_t>(max - min + 1));
+    }
+
+    // standard normal, Box-Muller
+    auto normal() -> float {
+        const auto u = 1.0f - uniform();
+        const auto v = uniform();
+        return std::sqrt(-2.0f * std::log(u)) * std::cos(2.0f * std::numbers::pi_v<float> * v);
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+// maps [min, max] onto [0, 1]
+struct Normalize {
+    float min;
+    float max;
+
+    auto operator()(std::span<float> input, SampleRandom&) const -> void {
+        const auto scale = 1.0f / (max - min);
+        for (auto& x : input) {
+            x = (x - min) * scale;
+        }
+    }
+};
+
+// zero mean and unit variance of every input, statistics are computed
+// once from the raw dataset
+struct Standardize {
+    std::vector<float> mean;
+    std::vector<float> scale;
+
+    static auto fit(const Dataset& dataset) -> Standardize {
+        const auto size = dataset.inputSize();
+        auto mean = std::vector<double>(size);
+        auto square = std::vector<double>(size);
+
+        for (auto i = 0; i < dataset.size(); ++i) {
+            const auto input = dataset.input(i);
+            for (auto n = 0; n < size; ++n) {
+                mean[n] += input[n];
+                square[n] += double(input[n]) * input[n];
+            }
+        }
+
+        auto standardize = Standardize { .mean = std::vector<float>(size), .scale = std::vector<float>(size) };
+        for (auto n = 0; n < size; ++n) {
+            const auto m = mean[n] / std::max(dataset.size(), 1);
+            const auto variance = square[n] / std::max(dataset.size(), 1) - m * m;
+
+            standardize.mean[n] = m;
+            // constant inputs are only centered
+            standardize.scale[n] = variance > 1e-12 ? 1.0 / std::sqrt(variance) : 1.0;
+        }
+        return standardize;
+    }
+
+    auto operator()(std::span<float> input, SampleRandom&) const -> void {
+        const auto m = mean.data();
+        const auto s = scale.data();
+        for (auto n = 0u; n < input.size(); ++n) {
+            input[n] = (input[n] - m[n]) * s[n];
+        }
+    }
+};
+
+// moves a row-major width x height image by up to maxShift pixels in both
+// directions, uncovered pixels are zero
+struct Shift {
+    static constexpr auto augmentation = true;
+
+    int width;
+    int height;
+    int maxShift;
+
+    auto operator()(std::span<float> input, SampleRandom& random) const -> void {
+        const auto dx = random(-maxShift, maxShift);
+        const auto dy = random(-maxShift, maxShift);
+        if (dx == 0 && dy == 0) {
+            return;
+        }
+
+        const auto columns = std::max(width - std::abs(dx), 0);
+        const auto image = input.data();
+
+        // rows are moved away from the direction of the shift, so that
+        // every source row is read before it is overwritten
+        for (auto k = 0; k < height; ++k) {
+            const auto row = dy > 0 ? height - 1 - k : k;
+            const auto source = row - dy;
+            const auto target = image + row * width;
+
+            if (source < 0 || source >= height || columns == 0) {
+                std::fill_n(target, width, 0.0f);
+                continue;
+            }
+
+            std::memmove(
+                target + std::max(dx, 0),
+                image + source * width + std::max(-dx, 0),
+                columns * sizeof(float)
+            );
+            std::fill_n(target + (dx > 0 ? 0 : columns), width - columns, 0.0f);
+        }
+    }
+};
+
+// additive gaussian noise
+struct Noise {
+    static constexpr auto augmentation = true;
+
+    float deviation;
+
+    auto operator()(std::span<float> input, SampleRandom& random) const -> void {
+        for (auto& x : input) {
+            x += deviation * random.normal();
+        }
+    }
+};
+
+// Stages applied in order to a sample's inputs, e.g.
+// Transforms(Shift { 28, 28, 2 }, Noise { 0.05f }, Normalize { 0, 1 }).
+// Applied lazily when samples are gathered for training, the raw dataset
+// is never modified nor copied. Augmentations (stages with a true static
+// augmentation member) are skipped when evaluating.
+struct Transforms {
+    using stage_function = std::function<void(std::span<float>, SampleRandom&)>;
+
+    Transforms() = default;
+
+    template<typename... Stages>
+    requires (sizeof...(Stages) > 0 && (!std::same_as<std::remove_cvref_t<Stages>, Transforms> && ...))
+    Transforms(Stages... stages) {
+        (then(std::move(stages)), ...);
+    }
+
+    template<typename Stage>
+    auto then(Stage stage) -> Transforms& {
+        constexpr auto augmentation = [] {
+            if constexpr (requires { Stage::augmentation; }) {
+                return bool(Stage::augmentation);
+            }
+            return false;
+        }();
+        stages_.push_back({ .function = std::move(stage), .augmentation = augmentation });
+        return *this;
+    }
+
+    auto empty() const -> bool { return stages_.empty(); }
+
+    // whether evaluation has anything to apply
+    auto evaluated() const -> bool {
+        return std::ranges::any_of(stages_, [](const auto& stage) { return !stage.augmentation; });
+    }
+
+    // key selects random choices of the sample, e.g. a hash of epoch and index
+    auto operator()(std::span<float> input, std::uint64_t key, bool augment = true) const -> void {
+        auto random = SampleRandom(key);
+        for (const auto& stage : stages_) {
+            if (augment || !stage.augmentation) {
+                stage.function(input, random);
+            }
+        }
+    }
+
+private:
+    struct Stage {
+        stage_function function;
+        bool augmentation;
+    };
+
+    std::vector<Stage> stages_;
+};
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace yam {
+
+// Lock free handoff of values from one writer thread to one reader thread.
+// The writer fills back() and publishes it, the reader picks the latest
+// published value with update() and reads front(). Neither ever waits,
+// values published between two updates are skipped.
+template<typename T>
+struct TripleBuffer {
+    TripleBuffer(const T& initial = T()) : slots_ { initial, initial, initial } { }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    auto operator=(const TripleBuffer&) -> TripleBuffer& = delete;
+
+    // writer side
+    auto back() -> T& { return slots_[back_]; }
+
+    auto publish() -> void {
+        back_ = middle_.exchange(back_ | fresh, std::memory_order_acq_rel) & index;
+    }
+
+    // reader side, returns whether a newer value was taken
+    auto update() -> bool {
+        if (!(middle_.load(std::memory_order_relaxed) & fresh)) {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & index;
+        return true;
+    }
+
+    auto front() const -> const T& { return slots_[front_]; }
+
+private:
+    static constexpr auto index = std::uint8_t(0b011);
+    static constexpr auto fresh = std::uint8_t(0b100);
+
+    std::array<T, 3> slots_;
+    std::uint8_t back_ = 0;
+    std::atomic<std::uint8_t> middle_ = 1;
+    std::uint8_t front_ = 2;
+};
+
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+namespace yam {
+
+enum class WeightLayout {
+    RowMajor, // weights of an upper neuron are contiguous, as MLPerceptron keeps them
+    Panels    // see PanelWeights
+};
+
+// Weights of every layer packed into panels of width upper neurons: for each
+// lower neuron the panel holds its weights to the panel's upper neurons side
+// by side. Forward, transposed products and corrections then all run over
+// contiguous runs of width floats, the last panel of a layer is zero padded.
+struct PanelWeights {
+    static constexpr auto width = 8;
+
+    PanelWeights() = default;
+
+    PanelWeights(std::span<const int> topology) : topology_(topology.begin(), topology.end()) {
+        auto offset = std::size_t(0);
+        for (auto layer = 0u; layer + 1 < topology_.size(); ++layer) {
+            offsets_.push_back(offset);
+            offset += panels(layer) * width * topology_[layer];
+        }
+        packed_.resize(offset);
+    }
+
+    // from row-major weights of all layers
+    auto pack(std::span<const float> weights) -> void {
+        visit([&](std::size_t packed, std::size_t weight) { packed_[packed] = weights[weight]; });
+    }
+
+    // into row-major weights of all layers
+    auto unpack(std::span<float> weights) const -> void {
+        visit([&](std::size_t packed, std::size_t weight) { weights[weight] = packed_[packed]; });
+    }
+
+    // upper = weights * lower of layer (0 is the first one), no bias nor activation
+    auto forward(int layer, const float* lower, float* upper) const -> void {
+        const auto lc = topology_[layer];
+        const auto uc = topology_[layer + 1];
+        auto panel = packed_.begin().base() + offsets_[layer];
+
+        for (auto first = 0; first < uc; first += width) {
+            auto sums = std::array<float, width>();
+            for (auto l = 0; l < lc; ++l, panel += width) {
+                for (auto k = 0; k < width; ++k) {
+                    sums[k] += panel[k] * lower[l];
+                }
+            }
+            std::copy_n(sums.begin(), std::min(width, uc - first), upper + first);
+        }
+    }
+
+    // lower = transposed(weights) * upper of layer, errors of upper neurons
+    // propagated to lower ones
+    auto transposed(int layer, const float* upper, float* lower) const -> void {
+        const auto lc = topology_[layer];
+        const auto uc = topology_[layer + 1];
+        auto panel = packed_.begin().base() + offsets_[layer];
+
+        std::fill(lower, lower + lc, 0.0f);
+        for (auto first = 0; first < uc; first += width) {
+            const auto values = padded(upper, first, uc);
+            for (auto l = 0; l < lc; ++l, panel += width) {
+                auto sum = 0.0f;
+                for (auto k = 0; k < width; ++k) {
+                    sum += panel[k] * values[k];
+                }
+                lower[l] += sum;
+            }
+        }
+    }
+
+    // weights += learnrate * error * transposed(signal) of layer
+    auto correct(int layer, const float* error, const float* signal, float learnrate) -> void {
+        const auto lc = topology_[layer];
+        const auto uc = topology_[layer + 1];
+        auto panel = packed_.begin().base() + offsets_[layer];
+
+        for (auto first = 0; first < uc; first += width) {
+            auto deltas = padded(error, first, uc);
+            for (auto& delta : deltas) {
+                delta *= learnrate;
+            }
+
+            for (auto l = 0; l < lc; ++l, panel += width) {
+                for (auto k = 0; k < width; ++k) {
+                    panel[k] += deltas[k] * signal[l];
+                }
+            }
+        }
+    }
+
+    auto packed() const -> std::span<const float> { return packed_; }
+
+private:
+    auto panels(int layer) const -> int {
+        return (topology_[layer + 1] + width - 1) / width;
+    }
+
+    // values [first, first + width) with zeros past size
+    static auto padded(const float* values, int first, int size) -> std::array<float, width> {
+        auto result = std::array<float, width>();
+        std::copy_n(values + first, std::min(width, size - first), result.begin());
+        return result;
+    }
+
+    // calls copy(packed, weight) with indexes of every weight in packed_
+    // and in row-major weights
+    template<typename Copy>
+    auto visit(Copy&& copy) const -> void {
+        auto weight = std::size_t(0);
+        for (auto layer = 0u; layer + 1 < topology_.size(); ++layer) {
+            const auto lc = topology_[layer];
+            const auto uc = topology_[layer + 1];
+
+            for (auto u = 0; u < uc; ++u) {
+                for (auto l = 0; l < lc; ++l) {
+                    copy(offsets_[layer] + ((u / width) * lc + l) * width + u % width, weight++);
+                }
+            }
+        }
+    }
+
+    std::vector<int> topology_;
+    std::vector<std::size_t> offsets_;
+    std::vector<float> packed_;
+};
+
+}
@@ -0,0 +1,74 @@
+#include <YetAnotherMlp/Dataset.hpp>
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/Transform.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// allocations made by the counting thread
+thread_local auto counting = false;
+thread_local auto allocations = 0;
+
+}
+
+auto operator new(std::size_t size) -> void* {
+    allocations += counting;
+    if (const auto memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+auto operator delete(void* memory) noexcept -> void { std::free(memory); }
+auto operator delete(void* memory, std::size_t) noexcept -> void { std::free(memory); }
+
+TEST(TestAllocations, steadyStateEpochsDoNotAllocate) {
+    auto inputs = std::vector<float>(500 * 6);
+    auto outputs = std::vector<float>(500 * 3);
+    auto random = yam::Random(2);
+    random(0.0f, 1.0f, inputs);
+    random(0.0f, 1.0f, outputs);
+
+    const auto dataset = yam::Dataset(inputs, outputs, 500);
+    const auto mlp = yam::MLPerceptron({6, 12, 8, 3}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    const auto options = std::vector<yam::MLPTrainer::Options> {
+        { .shuffling = yam::Shuffling::Samples },
+        { .shuffling = yam::Shuffling::Blocks },
+        { .shuffling = yam::Shuffling::Staged },
+        { .shuffling = yam::Shuffling::Samples, .checkpointEvery = 2 },
+        { .shuffling = yam::Shuffling::Staged, .transforms = yam::Transforms(yam::Normalize { 0.0f, 2.0f }) },
+        { .shuffling = yam::Shuffling::Samples, .transforms = yam::Transforms(yam::Normalize { 0.0f, 2.0f }) },
+        { .shuffling = yam::Shuffling::Staged, .validationSamples = 100, .fullValidationEvery = 3 },
+    };
+
+    for (auto o = 0u; o < options.size(); ++o) {
+        auto trainer = yam::MLPTrainer(mlp, 0.05, 0.0, 5, dataset, dataset, options[o]);
+
+        auto counts = std::vector<int>();
+        counts.reserve(16);
+
+        counting = true;
+        allocations = 0;
+        trainer.train([&](auto&& result) {
+            counts.push_back(std::exchange(allocations, 0));
+        });
+        counting = false;
+
+        // the first epoch sizes scratch buffers, later ones reuse them
+        ASSERT_EQ(counts.size(), 6u) << o;
+        for (auto epoch = 2u; epoch < counts.size(); ++epoch) {
+            ASSERT_EQ(counts[epoch], 0) << o << " epoch " << epoch;
+        }
+    }
+}
@@ -0,0 +1,172 @@
+#include <YetAnotherMlp/Convolution.hpp>
+#include <YetAnotherMlp/Dataset.hpp>
+#include <YetAnotherMlp/Evaluation.hpp>
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Random.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// direct convolution, relu and max pooling
+auto reference(
+    const yam::ConvolutionShape& shape,
+    std::span<const float> kernels,
+    std::span<const float> biases,
+    std::span<const float> image
+) -> std::vector<float> {
+    const auto [width, height, channels, filters, kernel, pool] = shape;
+    const auto ow = width - kernel + 1;
+    const auto oh = height - kernel + 1;
+
+    auto maps = std::vector<float>(filters * ow * oh);
+    for (auto f = 0; f < filters; ++f) {
+        for (auto y = 0; y < oh; ++y) {
+            for (auto x = 0; x < ow; ++x) {
+                auto sum = biases[f];
+                for (auto c = 0; c < channels; ++c) {
+                    for (auto ky = 0; ky < kernel; ++ky) {
+                        for (auto kx = 0; kx < kernel; ++kx) {
+                            sum += kernels[((f * channels + c) * kernel + ky) * kernel + kx]
+                                 * image[(c * height + y + ky) * width + x + kx];
+                        }
+                    }
+                }
+                maps[(f * oh + y) * ow + x] = std::max(sum, 0.0f);
+            }
+        }
+    }
+
+    auto pooled = std::vector<float>();
+    for (auto f = 0; f < filters; ++f) {
+        for (auto y = 0; y + pool <= oh; y += pool) {
+            for (auto x = 0; x + pool <= ow; x += pool) {
+                auto best = maps[(f * oh + y) * ow + x];
+                for (auto dy = 0; dy < pool; ++dy) {
+                    for (auto dx = 0; dx < pool; ++dx) {
+                        best = std::max(best, maps[(f * oh + y + dy) * ow + x + dx]);
+                    }
+                }
+                pooled.push_back(best);
+            }
+        }
+    }
+    return pooled;
+}
+
+}
+
+TEST(TestConvolution, forwardMatchesDirectConvolution) {
+    const auto shape = yam::ConvolutionShape {
+        .width = 9, .height = 8, .channels = 2, .filters = 3, .kernel = 3, .pool = 2
+    };
+    auto convolution = yam::Convolution(shape);
+    ASSERT_EQ(convolution.inputSize(), 9 * 8 * 2);
+    ASSERT_EQ(convolution.outputSize(), 3 * 3 * 3);
+
+    auto random = yam::Random(3);
+    random(-1.0f, 1.0f, convolution.kernels());
+    random(-0.5f, 0.5f, convolution.biases());
+
+    auto image = std::vector<float>(convolution.inputSize());
+    random(0.0f, 1.0f, image);
+
+    const auto expected = reference(shape, convolution.kernels(), convolution.biases(), image);
+    const auto actual = convolution.forward(image.data());
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (auto i = 0u; i < expected.size(); ++i) {
+        ASSERT_NEAR(actual[i], expected[i], 1e-5f) << i;
+    }
+}
+
+TEST(TestConvolution, backwardFollowsNumericGradient) {
+    const auto shape = yam::ConvolutionShape {
+        .width = 7, .height = 7, .channels = 1, .filters = 2, .kernel = 3, .pool = 2
+    };
+    auto convolution = yam::Convolution(shape);
+
+    auto random = yam::Random(9);
+    random(-1.0f, 1.0f, convolution.kernels());
+    random(0.1f, 0.5f, convolution.biases());
+
+    auto image = std::vector<float>(convolution.inputSize());
+    auto coefficients = std::vector<float>(convolution.outputSize());
+    random(0.0f, 1.0f, image);
+    random(-1.0f, 1.0f, coefficients);
+
+    // loss is a weighted sum of outputs, the trainer's errors are its
+    // negative gradient
+    const auto loss = [&](yam::Convolution& convolution) {
+        const auto output = convolution.forward(image.data());
+        return std::inner_product(output.begin(), output.end(), coefficients.begin(), 0.0);
+    };
+
+    auto numeric = std::vector<double>();
+    for (auto k = 0u; k < convolution.kernels().size(); ++k) {
+        auto plus = convolution;
+        auto minus = convolution;
+        plus.kernels()[k] += 1e-3f;
+        minus.kernels()[k] -= 1e-3f;
+        numeric.push_back((loss(plus) - loss(minus)) / 2e-3);
+    }
+
+    auto errors = coefficients;
+    std::ranges::transform(errors, errors.begin(), std::negate<>{});
+
+    auto trained = convolution;
+    trained.forward(image.data());
+    trained.backward(errors.data(), 1e-3f);
+
+    for (auto k = 0u; k < numeric.size(); ++k) {
+        const auto step = (trained.kernels()[k] - convolution.kernels()[k]) / 1e-3f;
+        ASSERT_NEAR(step, -numeric[k], 2e-2) << k;
+    }
+}
+
+TEST(TestConvolution, learningOrientationOfBars) {
+    constexpr auto side = 8;
+
+    // a horizontal or a vertical bar at a random position
+    auto random = yam::Random(1);
+    auto inputs = std::vector<float>();
+    auto outputs = std::vector<float>();
+    for (auto s = 0; s < 400; ++s) {
+        const auto vertical = s % 2;
+        const auto position = random(1, side - 2);
+        for (auto y = 0; y < side; ++y) {
+            for (auto x = 0; x < side; ++x) {
+                inputs.push_back((vertical ? x : y) == position ? 1.0f : random(0.0f, 0.2f));
+            }
+        }
+        outputs.push_back(vertical ? 0.0f : 1.0f);
+        outputs.push_back(vertical ? 1.0f : 0.0f);
+    }
+
+    const auto trainset = yam::Dataset(
+        std::vector(inputs.begin(), inputs.begin() + 300 * side * side),
+        std::vector(outputs.begin(), outputs.begin() + 300 * 2),
+        300
+    );
+    const auto testset = yam::Dataset(
+        std::vector(inputs.begin() + 300 * side * side, inputs.end()),
+        std::vector(outputs.begin() + 300 * 2, outputs.end()),
+        100
+    );
+
+    auto convolution = yam::Convolution({ .width = side, .height = side, .filters = 4, .kernel = 3, .pool = 2 });
+    auto mlp = yam::MLPerceptron({convolution.outputSize(), 8, 2}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Sigmoid
+    });
+    mlp.convolution(convolution);
+
+    auto trainer = yam::MLPTrainer(mlp, 0.05, 0.99, 50, trainset, testset, {
+        .seed = 2,
+        .metric = yam::Metric::Accuracy
+    });
+    const auto result = trainer.train();
+
+    ASSERT_GE(result.evaluation.accuracy(), 0.99f);
+}
@@ -0,0 +1,25 @@
+#include <YetAnotherMlp/Dataset.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(TestDataset, Gather) {
+    const auto dataset = yam::Dataset(
+        {1, 1, 2, 2, 3, 3, 4, 4},
+        {10, 20, 30, 40},
+        4
+    );
+
+    auto staged = yam::Dataset();
+    const auto order = std::vector { 2, 0, 3, 1 };
+
+    dataset.gather(order, staged);
+
+    ASSERT_EQ(staged.size(), 4);
+    ASSERT_EQ(staged.inputSize(), 2);
+    ASSERT_EQ(staged.outputSize(), 1);
+
+    for (auto k = 0; k < 4; ++k) {
+        ASSERT_TRUE(std::ranges::equal(staged.input(k), dataset.input(order[k])));
+        ASSERT_TRUE(std::ranges::equal(staged.output(k), dataset.output(order[k])));
+    }
+}
@@ -0,0 +1,68 @@
+#include <YetAnotherMlp/DatasetCache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+TEST(TestDatasetCache, SaveLoadRoundTrip) {
+    const auto path = (std::filesystem::temp_directory_path() / "yam-test.cache").string();
+
+    auto inputs = std::vector<float>(5 * 7);
+    for (auto i = 0u; i < inputs.size(); ++i) {
+        inputs[i] = i / 7.0f;
+    }
+    const auto dataset = yam::Dataset(inputs, {1, 0, 0, 1, 1, 0, 0, 1, 1, 0}, 5);
+    ASSERT_TRUE(yam::DatasetCache::save(dataset, path.c_str()));
+
+    const auto loaded = yam::DatasetCache::load(path.c_str());
+    ASSERT_TRUE(loaded);
+    ASSERT_TRUE(loaded->external());
+    ASSERT_EQ(loaded->size(), 5);
+    ASSERT_EQ(loaded->inputSize(), 7);
+    ASSERT_EQ(loaded->outputSize(), 2);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(loaded->inputs().data()) % yam::DatasetCache::alignment, 0);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(loaded->outputs().data()) % yam::DatasetCache::alignment, 0);
+    ASSERT_TRUE(std::ranges::equal(loaded->inputs(), dataset.inputs()));
+    ASSERT_TRUE(std::ranges::equal(loaded->outputs(), dataset.outputs()));
+
+    // copies share the mapping, staging into them gets owned samples
+    auto copy = *loaded;
+    ASSERT_EQ(copy.inputs().data(), loaded->inputs().data());
+
+    const auto order = std::vector { 4, 3, 2, 1, 0 };
+    loaded->gather(order, copy);
+    ASSERT_FALSE(copy.external());
+    ASSERT_TRUE(std::ranges::equal(copy.input(0), dataset.input(4)));
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestDatasetCache, RejectsBrokenFilesAndCachesOnce) {
+    const auto path = (std::filesystem::temp_directory_path() / "yam-test.cache").string();
+    std::filesystem::remove(path);
+
+    auto reads = 0;
+    const auto read = [&reads] {
+        ++reads;
+        return yam::Dataset({0.5f, 1.5f, 2.5f, 3.5f}, {1, 0}, 2);
+    };
+
+    ASSERT_FALSE(yam::DatasetCache::load(path.c_str()));
+    ASSERT_EQ(yam::DatasetCache::cached(path.c_str(), read).size(), 2);
+    ASSERT_EQ(yam::DatasetCache::cached(path.c_str(), read).size(), 2);
+    ASSERT_EQ(reads, 1);
+
+    // a flipped byte in the samples fails verification only
+    {
+        auto file = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(yam::DatasetCache::alignment + 1);
+        file.put(0x7f);
+    }
+    ASSERT_FALSE(yam::DatasetCache::load(path.c_str()));
+    ASSERT_TRUE(yam::DatasetCache::load(path.c_str(), false));
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    ASSERT_FALSE(yam::DatasetCache::load(path.c_str(), false));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,106 @@
+#include <YetAnotherMlp/Distributed.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+// runs body(rank, port) in size processes, rank 0 in the calling one
+template<typename Body>
+auto ranks(int size, Body&& body) -> bool {
+    const auto port = static_cast<std::uint16_t>(20000 + ::getpid() % 20000);
+
+    auto children = std::vector<pid_t>();
+    for (auto rank = 1; rank < size; ++rank) {
+        const auto pid = ::fork();
+        if (pid == 0) {
+            ::_exit(body(rank, port) ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+
+    auto success = body(0, port);
+    for (const auto pid : children) {
+        auto status = 0;
+        ::waitpid(pid, &status, 0);
+        success = success && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    return success;
+}
+
+}
+
+TEST(TestDistributed, RingAllReduce) {
+    for (const auto size : {1, 2, 3, 4}) {
+        ASSERT_TRUE(ranks(size, [size](int rank, std::uint16_t port) {
+            auto ring = yam::Ring(rank, size, port);
+
+            // not divisible by size, so chunks differ in length
+            auto values = std::vector<float>(1001);
+            for (auto i = 0u; i < values.size(); ++i) {
+                values[i] = rank * 1000.0f + i;
+            }
+
+            if (!ring.allReduce(values)) {
+                return false;
+            }
+
+            for (auto i = 0u; i < values.size(); ++i) {
+                if (values[i] != 1000.0f * size * (size - 1) / 2 + float(i) * size) {
+                    return false;
+                }
+            }
+            return true;
+        })) << size;
+    }
+}
+
+TEST(TestDistributed, DataParallelTrainingKeepsRanksInSync) {
+    auto inputs = std::vector<float>(400 * 4);
+    auto outputs = std::vector<float>(400 * 2);
+    auto random = yam::Random(3);
+    random(0.0f, 1.0f, inputs);
+    for (auto s = 0; s < 400; ++s) {
+        outputs[s * 2 + (inputs[s * 4] > inputs[s * 4 + 1])] = 1;
+    }
+
+    const auto dataset = yam::Dataset(inputs, outputs, 400);
+    const auto size = 3;
+
+    for (const auto overlap : {false, true}) {
+        ASSERT_TRUE(ranks(size, [&](int rank, std::uint16_t port) {
+            auto ring = yam::Ring(rank, size, port);
+            auto parallel = yam::DataParallel(ring, overlap);
+
+            // different seeds, ranks start from the averaged model
+            auto trainer = yam::MLPTrainer(
+                yam::MLPerceptron({4, 8, 2}, true, {yam::ActivationFunctionType::Sigmoid}),
+                0.5, 0.0, 20, yam::shard(dataset, rank, size), dataset, {
+                    .seed = std::uint32_t(rank),
+                    .synchronize = std::ref(parallel),
+                    .synchronizeEvery = 16
+                }
+            );
+
+            const auto error = trainer.train().error;
+
+            // every rank holds the same weights when their sum is size times own
+            const auto weights = trainer.trainee().weights();
+            auto summed = std::vector<float>(weights.begin(), weights.end());
+            if (!ring.allReduce(summed) || !parallel.valid()) {
+                return false;
+            }
+
+            for (auto i = 0u; i < weights.size(); ++i) {
+                if (summed[i] != weights[i] * size) {
+                    return false;
+                }
+            }
+            return error < 0.1f;
+        })) << overlap;
+    }
+}
@@ -0,0 +1,72 @@
+#include <YetAnotherMlp/EnsembleTrainer.hpp>
+#include <YetAnotherMlp/MLPerceptron.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+auto xorDataset() -> yam::Dataset {
+    return yam::Dataset(
+        {1, 0, 0, 0, 0, 1, 1, 1},
+        {1, 0, 1, 0},
+        4
+    );
+}
+
+}
+
+TEST(TestEnsembleTrainer, ModelsMatchEnsembleForward) {
+    const auto prototype = yam::MLPerceptron({2, 3, 2}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Sigmoid
+    });
+    const auto dataset = yam::Dataset({0.5f, -1.0f}, {1.0f, 0.0f}, 1);
+
+    auto ensemble = yam::EnsembleTrainer(prototype, {0.1f, 0.2f, 0.3f}, {1, 2, 3}, dataset, dataset);
+    ensemble.epoch();
+
+    const auto input = std::vector { 0.25f, 0.75f };
+    const auto outputs = ensemble.forward(input.data());
+    const auto actual = std::vector<float>(outputs.begin(), outputs.end());
+
+    for (auto k = 0; k < ensemble.size(); ++k) {
+        auto model = ensemble.model(k);
+        const auto expected = model.forward(input.data());
+        for (auto o = 0; o < 2; ++o) {
+            ASSERT_NEAR(actual[o * ensemble.size() + k], expected[o], 1e-6);
+        }
+    }
+}
+
+TEST(TestEnsembleTrainer, SameSeedAndLearnrateGiveSameModels) {
+    const auto prototype = yam::MLPerceptron({2, 4, 1}, true, {yam::ActivationFunctionType::Sigmoid});
+    const auto dataset = xorDataset();
+
+    auto ensemble = yam::EnsembleTrainer(prototype, {2.0f, 2.0f, 5.0f}, {7, 7, 7}, dataset, dataset);
+    for (auto e = 0; e < 100; ++e) {
+        ensemble.epoch();
+    }
+
+    const auto first = ensemble.model(0);
+    const auto second = ensemble.model(1);
+    const auto third = ensemble.model(2);
+
+    for (auto w = 0; w < first.weights().size(); ++w) {
+        ASSERT_NEAR(first.weights()[w], second.weights()[w], 1e-6);
+    }
+    ASSERT_FALSE(std::ranges::equal(first.weights(), third.weights()));
+}
+
+TEST(TestEnsembleTrainer, LearningXor) {
+    const auto prototype = yam::MLPerceptron({2, 4, 1}, true, {yam::ActivationFunctionType::Sigmoid});
+    const auto dataset = xorDataset();
+
+    auto ensemble = yam::EnsembleTrainer(prototype, {1.0f, 2.0f, 5.0f, 10.0f}, {1, 2, 3, 4}, dataset, dataset);
+
+    auto errors = ensemble.evaluate();
+    for (auto e = 0; e < 4000; ++e) {
+        errors = ensemble.epoch();
+    }
+
+    ASSERT_LE(std::ranges::min(errors), 0.01f);
+}
@@ -0,0 +1,98 @@
+#include <YetAnotherMlp/Evaluation.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Random.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// outputs equal inputs
+auto identity(int size) -> yam::MLPerceptron {
+    auto mlp = yam::MLPerceptron({size, size}, false, {yam::ActivationFunctionType::Linear});
+    for (auto i = 0; i < size; ++i) {
+        mlp.weights()[i * size + i] = 1;
+    }
+    return mlp;
+}
+
+}
+
+TEST(TestEvaluation, MetricsOfKnownOutputs) {
+    const auto dataset = yam::Dataset(
+        {
+            0.9f, 0.1f, 0.0f, // class 0, predicted 0
+            0.2f, 0.7f, 0.1f, // class 1, predicted 1
+            0.5f, 0.3f, 0.2f, // class 2, predicted 0, third
+            0.1f, 0.6f, 0.3f  // class 2, predicted 1, second
+        },
+        {
+            1, 0, 0,
+            0, 1, 0,
+            0, 0, 1,
+            0, 0, 1
+        },
+        4
+    );
+
+    auto mlp = identity(3);
+    const auto evaluation = yam::evaluate(dataset, mlp, {.k = 2});
+
+    ASSERT_EQ(evaluation.samples, 4);
+    ASSERT_FLOAT_EQ(evaluation.accuracy(), 0.5f);
+    ASSERT_FLOAT_EQ(evaluation.topKAccuracy(), 0.75f);
+
+    ASSERT_EQ(evaluation.count(0, 0), 1);
+    ASSERT_EQ(evaluation.count(1, 1), 1);
+    ASSERT_EQ(evaluation.count(2, 0), 1);
+    ASSERT_EQ(evaluation.count(2, 1), 1);
+    ASSERT_EQ(evaluation.count(2, 2), 0);
+
+    const auto expectedError = (0.02f + 0.14f + 0.98f + 0.86f) / 4;
+    ASSERT_NEAR(evaluation.error(), expectedError, 1e-6f);
+}
+
+TEST(TestEvaluation, ParallelMatchesSerial) {
+    auto inputs = std::vector<float>(1000 * 10);
+    auto outputs = std::vector<float>(1000 * 10);
+    auto random = yam::Random(8);
+    random(0.0f, 1.0f, inputs);
+    for (auto s = 0; s < 1000; ++s) {
+        outputs[s * 10 + random(0, 9)] = 1;
+    }
+    const auto dataset = yam::Dataset(inputs, outputs, 1000);
+
+    auto mlp = yam::MLPerceptron({10, 16, 10}, true, {yam::ActivationFunctionType::Sigmoid});
+    random(-1.0f, 1.0f, mlp.weights());
+
+    auto pool = yam::ThreadPool(4);
+    const auto serial = yam::evaluate(dataset, mlp);
+    const auto parallel = yam::evaluate(dataset, mlp, {.pool = &pool});
+
+    ASSERT_EQ(serial.distance, parallel.distance);
+    ASSERT_EQ(serial.correct, parallel.correct);
+    ASSERT_EQ(serial.correctTopK, parallel.correctTopK);
+    ASSERT_EQ(serial.confusion, parallel.confusion);
+}
+
+TEST(TestEvaluation, TrainingStopsOnAccuracy) {
+    const auto dataset = yam::Dataset(
+        {1, 0, 0, 0, 0, 1, 1, 1},
+        {1, 0, 1, 0},
+        4
+    );
+
+    auto trainer = yam::MLPTrainer(
+        yam::MLPerceptron({2, 3, 1}, true, {yam::ActivationFunctionType::Sigmoid}),
+        1, 1.0, 10000, dataset, dataset, {
+            .seed = 1,
+            .metric = yam::Metric::Accuracy
+        }
+    );
+
+    const auto result = trainer.train();
+
+    ASSERT_LT(result.epoch, 10000);
+    ASSERT_EQ(result.evaluation.accuracy(), 1.0f);
+    ASSERT_EQ(result.evaluation.count(1, 1), 2);
+    ASSERT_EQ(result.evaluation.count(0, 0), 2);
+}
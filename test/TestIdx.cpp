@@ -0,0 +1,112 @@
+#include <YetAnotherMlp/Idx.hpp>
+#include <YetAnotherMlp/Mnist.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+
+TEST(TestIdx, RoundTripsEveryTypeAndRank) {
+    const auto values = std::vector { 0.0f, 1.0f, -2.0f, 127.0f, 3.0f, -128.0f, 5.0f, 6.0f };
+
+    for (const auto type : {
+        yam::IdxType::Int8, yam::IdxType::Int16, yam::IdxType::Int32,
+        yam::IdxType::Float, yam::IdxType::Double
+    }) {
+        for (const auto& dimensions : {
+            std::vector<std::uint32_t> { 8 },
+            std::vector<std::uint32_t> { 4, 2 },
+            std::vector<std::uint32_t> { 2, 2, 2 },
+            std::vector<std::uint32_t> { 1, 2, 2, 2 }
+        }) {
+            auto stream = std::stringstream();
+            ASSERT_TRUE(yam::Idx::write(stream, type, dimensions, values));
+
+            const auto header = yam::Idx::header(stream);
+            ASSERT_TRUE(header);
+            ASSERT_EQ(header->type, type);
+            ASSERT_EQ(header->dimensions, dimensions);
+            ASSERT_EQ(header->elementsPerItem(), values.size() / dimensions.front());
+
+            auto bytes = std::vector<std::uint8_t>(values.size() * header->elementSize());
+            stream.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+
+            auto decoded = std::vector<float>(values.size());
+            yam::Idx::decode(type, bytes.data(), decoded);
+            ASSERT_EQ(decoded, values);
+        }
+    }
+
+    // unsigned bytes saturate the negatives, integers round
+    auto stream = std::stringstream();
+    ASSERT_TRUE(yam::Idx::write(stream, yam::IdxType::UInt8, std::vector<std::uint32_t> { 4 }, std::vector { -3.0f, 2.6f, 255.0f, 300.0f }));
+    ASSERT_TRUE(yam::Idx::header(stream));
+
+    auto bytes = std::vector<std::uint8_t>(4);
+    stream.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+    ASSERT_EQ(bytes, (std::vector<std::uint8_t> { 0, 3, 255, 255 }));
+}
+
+TEST(TestIdx, ReadsInChunksAndRejectsBrokenFiles) {
+    const auto path = (std::filesystem::temp_directory_path() / "yam-test.idx").string();
+    const auto elements = yam::Idx::chunk * 2 + 123;
+
+    auto values = std::vector<float>(elements);
+    for (auto i = 0; i < elements; ++i) {
+        values[i] = static_cast<float>(i % 30000 - 15000);
+    }
+    const auto dimensions = std::vector<std::uint32_t> { static_cast<std::uint32_t>(elements) };
+    ASSERT_TRUE(yam::Idx::write(path.c_str(), yam::IdxType::Int16, dimensions, values));
+
+    auto reader = yam::IdxReader(path.c_str());
+    ASSERT_TRUE(reader.valid());
+    ASSERT_EQ(reader.remaining(), elements);
+
+    auto read = std::vector<float>();
+    auto chunk = std::vector<float>(1000);
+    while (const auto count = reader.read(chunk)) {
+        read.insert(read.end(), chunk.begin(), chunk.begin() + count);
+    }
+    ASSERT_EQ(read, values);
+    ASSERT_EQ(reader.remaining(), 0);
+
+    // data shorter than the header declares
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    ASSERT_FALSE(yam::IdxReader(path.c_str()).valid());
+
+    auto unknown = std::stringstream(std::string("\0\0\x07\x01\0\0\0\0", 8));
+    ASSERT_FALSE(yam::Idx::header(unknown));
+
+    auto shortHeader = std::stringstream(std::string("\0\0\x08\x03\0\0\0\x01", 8));
+    ASSERT_FALSE(yam::Idx::header(shortHeader));
+
+    ASSERT_FALSE(yam::IdxReader("missing.idx").valid());
+    std::filesystem::remove(path);
+}
+
+TEST(TestIdx, MnistReadsImagesAndLabels) {
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto images = (directory / "yam-test-images.idx").string();
+    const auto labels = (directory / "yam-test-labels.idx").string();
+
+    const auto pixels = std::vector { 0.0f, 64.0f, 128.0f, 255.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f };
+    ASSERT_TRUE(yam::Idx::write(images.c_str(), yam::IdxType::UInt8, std::vector<std::uint32_t> { 3, 2, 2 }, pixels));
+    ASSERT_TRUE(yam::Idx::write(labels.c_str(), yam::IdxType::UInt8, std::vector<std::uint32_t> { 3 }, std::vector { 3.0f, 0.0f, 11.0f }));
+
+    const auto dataset = yam::Mnist::read(images.c_str(), labels.c_str());
+    ASSERT_EQ(dataset.size(), 3);
+    ASSERT_EQ(dataset.inputSize(), 4);
+    ASSERT_EQ(dataset.outputSize(), 12);
+
+    ASSERT_FLOAT_EQ(dataset.input(0)[3], 255.0f / 256.0f);
+    ASSERT_EQ(dataset.output(0)[3], 1.0f);
+    ASSERT_EQ(dataset.output(1)[0], 1.0f);
+    ASSERT_EQ(dataset.output(2)[11], 1.0f);
+
+    // labels of another count than images
+    ASSERT_TRUE(yam::Idx::write(labels.c_str(), yam::IdxType::UInt8, std::vector<std::uint32_t> { 2 }, std::vector { 3.0f, 0.0f }));
+    ASSERT_EQ(yam::Mnist::read(images.c_str(), labels.c_str()).size(), 0);
+
+    std::filesystem::remove(images);
+    std::filesystem::remove(labels);
+}
@@ -1,5 +1,6 @@
 #include <YetAnotherMlp/Activation.hpp>
 #include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/Random.hpp>
 
 #include <gtest/gtest.h>
 
@@ -62,4 +63,87 @@
     
 //     ASSERT_EQ(result.size(), 1);
 //     ASSERT_FLOAT_EQ(result[0], 35.3f);
-// }
\ No newline at end of file
+// }
+TEST(TestMLPerceptron, ReluActivation) {
+    auto mlp = yam::MLPerceptron({2, 2}, false, {yam::ActivationFunctionType::Relu});
+
+    const auto weights = std::vector { 1.0f, 2.0f, -3.0f, 1.0f };
+    std::ranges::copy(weights, mlp.weights().begin());
+
+    const auto input = std::vector { 1.0f, 1.0f };
+    const auto result = mlp.forward(input.data());
+
+    ASSERT_EQ(result.size(), 2);
+    ASSERT_FLOAT_EQ(result[0], 3.0f);
+    ASSERT_FLOAT_EQ(result[1], 0.0f);
+}
+
+TEST(TestMLPerceptron, PerLayerActivations) {
+    auto mlp = yam::MLPerceptron({1, 2, 1}, true, {
+        yam::ActivationFunctionType::LeakyRelu,
+        yam::ActivationFunctionType::Tanh
+    });
+
+    const auto weights = std::vector { 2.0f, -1.0f, 0.5f, 1.0f };
+    const auto biases = std::vector { 0.0f, 0.0f, 0.1f };
+    std::ranges::copy(weights, mlp.weights().begin());
+    std::ranges::copy(biases, mlp.biases().begin());
+
+    const auto input = std::vector { 1.0f };
+    const auto result = mlp.forward(input.data());
+
+    ASSERT_EQ(result.size(), 1);
+    ASSERT_FLOAT_EQ(mlp.neurons()[0], 2.0f);
+    ASSERT_FLOAT_EQ(mlp.neurons()[1], -0.01f);
+    ASSERT_FLOAT_EQ(result[0], std::tanh(0.5f * 2.0f - 0.01f + 0.1f));
+}
+
+TEST(TestMLPerceptron, SparseInputMatchesDense) {
+    auto mlp = yam::MLPerceptron({8, 3}, true, {yam::ActivationFunctionType::Linear});
+
+    for (auto i = 0; i < mlp.weights().size(); ++i) {
+        mlp.weights()[i] = 0.1f * i;
+    }
+    std::ranges::fill(mlp.biases(), 1.0f);
+
+    const auto input = std::vector { 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f };
+
+    const auto result = mlp.forward(input.data());
+    const auto sparse = std::vector<float>(result.begin(), result.end());
+    ASSERT_TRUE(mlp.sparseInput());
+    ASSERT_EQ(mlp.inputIndexes().size(), 2);
+
+    mlp.sparseDensity(0.0f);
+    const auto dense = mlp.forward(input.data());
+    ASSERT_FALSE(mlp.sparseInput());
+
+    for (auto u = 0; u < 3; ++u) {
+        const auto expected = 1.0f + 2.0f * mlp.weights()[u * 8 + 1] - mlp.weights()[u * 8 + 5];
+        ASSERT_FLOAT_EQ(sparse[u], expected);
+        ASSERT_FLOAT_EQ(dense[u], expected);
+    }
+}
+
+TEST(TestMLPerceptron, ParallelForwardMatchesSerial) {
+    auto mlp = yam::MLPerceptron({64, 100, 10}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    auto random = yam::Random(5);
+    random(-1.0f, 1.0f, mlp.weights());
+    random(-1.0f, 1.0f, mlp.biases());
+
+    auto input = std::vector<float>(64);
+    random(-1.0f, 1.0f, input);
+
+    const auto serial = mlp.forward(input.data());
+    const auto expected = std::vector<float>(serial.begin(), serial.end());
+
+    auto pool = yam::ThreadPool(4);
+    mlp.parallelize(&pool, 0);
+
+    const auto parallel = mlp.forward(input.data());
+
+    ASSERT_TRUE(std::ranges::equal(parallel, expected));
+}
@@ -38,6 +38,141 @@ TEST(TestMLTrainer, learningXor) {
     ASSERT_LE(actualError, expectedError);
 }
 
+TEST(TestMLTrainer, learningXorPerLayerActivations) {
+    auto mlp = yam::MLPerceptron({2, 4, 1}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    const auto input = std::vector {
+        1.0f, 0.0f,
+        0.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+    const auto expected = std::vector {
+        1.0f,
+        0.0f,
+        1.0f,
+        0.0f
+    };
+
+    const auto dataset = yam::Dataset(input, expected, 4);
+
+    const auto expectedError = 0.01;
+
+    auto trainer = yam::MLPTrainer(mlp, 1, 0.01, 4000, dataset, dataset);
+
+    auto actualError = std::numeric_limits<float>::max();
+    for (auto i = 0; i < 10 && actualError > expectedError; ++i) {
+        actualError = trainer.train().error;
+    }
+
+    ASSERT_LE(actualError, expectedError);
+}
+
+TEST(TestMLTrainer, learningXorParallelEvaluation) {
+    auto mlp = yam::MLPerceptron({2, 2, 1}, true, yam::Activation::sigmoid);
+
+    const auto input = std::vector {
+        1.0f, 0.0f,
+        0.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+    const auto expected = std::vector {
+        1.0f,
+        0.0f,
+        1.0f,
+        0.0f
+    };
+
+    const auto dataset = yam::Dataset(input, expected, 4);
+
+    const auto expectedError = 0.01;
+
+    auto pool = yam::ThreadPool(4);
+    auto trainer = yam::MLPTrainer(mlp, 20, 0.01, 4000, dataset, dataset, yam::Derivation::sigmoid, {.pool = &pool});
+
+    auto actualError = std::numeric_limits<float>::max();
+    for (auto i = 0; i < 10 && actualError > expectedError; ++i) {
+        actualError = trainer.train().error;
+    }
+
+    ASSERT_LE(actualError, expectedError);
+}
+
+TEST(TestMLTrainer, learningXorShufflings) {
+    const auto input = std::vector {
+        1.0f, 0.0f,
+        0.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+    const auto expected = std::vector {
+        1.0f,
+        0.0f,
+        1.0f,
+        0.0f
+    };
+
+    const auto dataset = yam::Dataset(input, expected, 4);
+
+    const auto expectedError = 0.01;
+
+    for (const auto shuffling : {yam::Shuffling::Samples, yam::Shuffling::Blocks, yam::Shuffling::Staged}) {
+        auto mlp = yam::MLPerceptron({2, 2, 1}, true, yam::Activation::sigmoid);
+        auto trainer = yam::MLPTrainer(mlp, 20, 0.01, 4000, dataset, dataset, yam::Derivation::sigmoid, {
+            .shuffling = shuffling
+        });
+
+        auto actualError = std::numeric_limits<float>::max();
+        for (auto i = 0; i < 10 && actualError > expectedError; ++i) {
+            actualError = trainer.train().error;
+        }
+
+        ASSERT_LE(actualError, expectedError);
+    }
+}
+
+TEST(TestMLTrainer, seededTrainingIsReproducibleAcrossThreads) {
+    auto inputs = std::vector<float>(300 * 4);
+    auto outputs = std::vector<float>(300 * 2);
+    auto random = yam::Random(11);
+    random(0.0f, 1.0f, inputs);
+    random(0.0f, 1.0f, outputs);
+
+    const auto dataset = yam::Dataset(inputs, outputs, 300);
+    const auto mlp = yam::MLPerceptron({4, 16, 2}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    const auto train = [&](yam::ThreadPool* pool, yam::Initialization initialization) {
+        auto trainer = yam::MLPTrainer(mlp, 0.1, 0.0, 5, dataset, dataset, {
+            .pool = pool,
+            .seed = 42,
+            .initialization = initialization
+        });
+        trainer.trainee().parallelize(pool, 0);
+
+        const auto error = trainer.train().error;
+        const auto weights = trainer.trainee().weights();
+        return std::make_pair(error, std::vector<float>(weights.begin(), weights.end()));
+    };
+
+    auto single = yam::ThreadPool(1);
+    auto many = yam::ThreadPool(4);
+
+    for (const auto initialization : {yam::Initialization::Separated, yam::Initialization::Xavier}) {
+        const auto expected = train(nullptr, initialization);
+
+        ASSERT_EQ(train(nullptr, initialization), expected);
+        ASSERT_EQ(train(&single, initialization), expected);
+        ASSERT_EQ(train(&many, initialization), expected);
+    }
+}
+
 TEST(TestMLTrainer, learningSinus) {
     auto inputs = std::vector<float>(100);
     auto outputs = std::vector<float>(100);
@@ -101,4 +236,85 @@ TEST(TestMLTrainer, learningMnist) {
     }
 
     std::cout << "Mnist error: " << error << "\n";
-}
\ No newline at end of file
+}
+TEST(TestMLTrainer, checkpointedTrainingMatchesRegular) {
+    auto inputs = std::vector<float>(200 * 4);
+    auto outputs = std::vector<float>(200 * 2);
+    auto random = yam::Random(5);
+    random(0.1f, 1.0f, inputs);
+    random(0.0f, 1.0f, outputs);
+
+    const auto dataset = yam::Dataset(inputs, outputs, 200);
+    const auto mlp = yam::MLPerceptron({4, 8, 6, 10, 5, 7, 2}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    const auto train = [&](int checkpointEvery) {
+        auto trainer = yam::MLPTrainer(mlp, 0.1, 0.0, 3, dataset, dataset, {
+            .seed = 7,
+            .checkpointEvery = checkpointEvery
+        });
+
+        const auto error = trainer.train().error;
+        const auto weights = trainer.trainee().weights();
+        return std::make_tuple(error, std::vector<float>(weights.begin(), weights.end()), trainer.stateBytes());
+    };
+
+    const auto [error, weights, bytes] = train(0);
+
+    for (const auto every : {1, 2, 3, 4, 6, 10}) {
+        const auto [checkpointedError, checkpointedWeights, checkpointedBytes] = train(every);
+        ASSERT_EQ(checkpointedError, error) << every;
+        ASSERT_EQ(checkpointedWeights, weights) << every;
+        ASSERT_LT(checkpointedBytes, bytes) << every;
+    }
+}
+
+TEST(TestMLTrainer, validationDoesNotChangeTraining) {
+    auto inputs = std::vector<float>(300 * 4);
+    auto outputs = std::vector<float>(300 * 2);
+    auto random = yam::Random(3);
+    random(0.0f, 1.0f, inputs);
+    random(0.0f, 1.0f, outputs);
+
+    const auto dataset = yam::Dataset(inputs, outputs, 300);
+    const auto mlp = yam::MLPerceptron({4, 16, 2}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    auto full = yam::MLPTrainer(mlp, 0.1, 0.0, 6, dataset, dataset, { .seed = 9 });
+    auto partial = yam::MLPTrainer(mlp, 0.1, 0.0, 6, dataset, dataset, {
+        .seed = 9,
+        .validationSamples = 50,
+        .fullValidationEvery = 3,
+        .asyncValidation = true
+    });
+
+    auto fullResults = std::vector<yam::MLPTrainer::Result>();
+    auto partialResults = std::vector<yam::MLPTrainer::Result>();
+    const auto fullResult = full.train([&](auto&& result) { fullResults.push_back(result); });
+    const auto partialResult = partial.train([&](auto&& result) { partialResults.push_back(result); });
+
+    ASSERT_EQ(fullResults.size(), partialResults.size());
+    for (auto r = 1u; r + 1 < partialResults.size(); ++r) {
+        const auto& result = partialResults[r];
+        // results of background validations come one epoch late
+        ASSERT_EQ(result.validatedEpoch, result.epoch - 1);
+        ASSERT_EQ(result.evaluation.samples, result.validatedEpoch % 3 == 0 ? 300 : 50);
+        if (result.validatedEpoch % 3 == 0) {
+            ASSERT_EQ(result.error, fullResults[r - 1].error);
+        }
+    }
+
+    // the last epoch is validated on the whole testset before returning
+    ASSERT_EQ(partialResult.validatedEpoch, 6);
+    ASSERT_EQ(partialResult.evaluation.samples, 300);
+    ASSERT_EQ(partialResult.error, fullResult.error);
+
+    const auto fullWeights = full.trainee().weights();
+    const auto partialWeights = partial.trainee().weights();
+    ASSERT_TRUE(std::ranges::equal(fullWeights, partialWeights));
+}
@@ -0,0 +1,44 @@
+#include <YetAnotherMlp/Model.hpp>
+#include <YetAnotherMlp/Random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+TEST(TestModel, SaveLoadRoundTrip) {
+    for (const auto bias : {false, true}) {
+        auto mlp = yam::MLPerceptron({5, 7, 3}, bias, {
+            yam::ActivationFunctionType::Relu,
+            yam::ActivationFunctionType::Sigmoid
+        });
+
+        auto random = yam::Random(3);
+        random(-1.0f, 1.0f, mlp.weights());
+        random(-1.0f, 1.0f, mlp.biases());
+
+        auto stream = std::stringstream();
+        ASSERT_TRUE(yam::Model::save(mlp, stream));
+
+        auto loaded = yam::Model::load(stream);
+        ASSERT_TRUE(loaded);
+
+        ASSERT_TRUE(std::ranges::equal(loaded->topology(), mlp.topology()));
+        ASSERT_TRUE(std::ranges::equal(loaded->activations(), mlp.activations()));
+        ASSERT_TRUE(std::ranges::equal(loaded->weights(), mlp.weights()));
+        ASSERT_TRUE(std::ranges::equal(loaded->biases(), mlp.biases()));
+
+        const auto input = std::vector { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f };
+        ASSERT_TRUE(std::ranges::equal(loaded->forward(input.data()), mlp.forward(input.data())));
+    }
+}
+
+TEST(TestModel, RejectsCustomActivationsAndBrokenFiles) {
+    auto custom = std::stringstream();
+    ASSERT_FALSE(yam::Model::save(yam::MLPerceptron({2, 1}, true, yam::Activation::sigmoid), custom));
+    ASSERT_FALSE(yam::Model::load(custom));
+
+    auto stream = std::stringstream();
+    ASSERT_TRUE(yam::Model::save(yam::MLPerceptron({2, 4, 1}, true, {yam::ActivationFunctionType::Tanh}), stream));
+    auto truncated = std::stringstream(stream.str().substr(0, stream.str().size() - 1));
+    ASSERT_FALSE(yam::Model::load(truncated));
+}
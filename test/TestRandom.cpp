@@ -0,0 +1,97 @@
+#include <YetAnotherMlp/Initialization.hpp>
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/ThreadPool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+auto philox(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key) {
+    const auto seed = std::uint64_t(key[1]) << 32 | key[0];
+    const auto stream = std::uint64_t(counter[3]) << 32 | counter[2];
+    const auto block = std::uint64_t(counter[1]) << 32 | counter[0];
+    return yam::Philox(seed, stream)(block);
+}
+
+}
+
+// known answers of the Random123 reference implementation
+TEST(TestRandom, philoxMatchesReference) {
+    using block = yam::Philox::block_type;
+
+    ASSERT_EQ(philox({0, 0, 0, 0}, {0, 0}), (block { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+    ASSERT_EQ(
+        philox({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+        (block { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd })
+    );
+    ASSERT_EQ(
+        philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+        (block { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 })
+    );
+}
+
+TEST(TestRandom, philoxRangesDoNotDependOnChunks) {
+    const auto random = yam::Philox(5, 3);
+
+    auto whole = std::vector<float>(1001);
+    random.normal(whole, 1.0f, 2.0f);
+
+    auto chunked = std::vector<float>(whole.size());
+    for (auto first = 0u; first < chunked.size(); first += 7) {
+        const auto size = std::min<std::size_t>(7, chunked.size() - first);
+        random.normal(std::span(chunked).subspan(first, size), 1.0f, 2.0f, first);
+    }
+    ASSERT_EQ(chunked, whole);
+
+    auto mean = 0.0;
+    auto square = 0.0;
+    auto values = std::vector<float>(100000);
+    random.normal(values, 1.0f, 2.0f);
+    for (const auto value : values) {
+        mean += value;
+        square += value * value;
+    }
+    mean /= values.size();
+    ASSERT_NEAR(mean, 1.0, 0.05);
+    ASSERT_NEAR(std::sqrt(square / values.size() - mean * mean), 2.0, 0.05);
+
+    random.uniform(values, -3.0f, 3.0f);
+    ASSERT_TRUE(std::ranges::all_of(values, [](float value) { return value >= -3.0f && value < 3.0f; }));
+}
+
+TEST(TestRandom, initializationDoesNotDependOnPool) {
+    auto pool = yam::ThreadPool(4);
+
+    for (const auto initialization : {
+        yam::Initialization::Separated,
+        yam::Initialization::Xavier,
+        yam::Initialization::He
+    }) {
+        auto serial = yam::MLPerceptron({300, 400, 10}, true, {yam::ActivationFunctionType::Relu});
+        auto parallel = serial;
+
+        yam::initialize(serial, initialization, 17);
+        yam::initialize(parallel, initialization, 17, &pool);
+
+        ASSERT_TRUE(std::ranges::equal(serial.weights(), parallel.weights()));
+        ASSERT_TRUE(std::ranges::equal(serial.biases(), parallel.biases()));
+    }
+
+    auto mlp = yam::MLPerceptron({300, 400, 10}, true, {yam::ActivationFunctionType::Relu});
+
+    yam::initialize(mlp, yam::Initialization::Xavier, 1);
+    const auto limit = std::sqrt(6.0f / 700.0f);
+    const auto first = mlp.weights().first(300 * 400);
+    ASSERT_TRUE(std::ranges::all_of(first, [&](float w) { return std::abs(w) <= limit; }));
+    ASSERT_GT(std::ranges::max(first), 0.9f * limit);
+    ASSERT_TRUE(std::ranges::all_of(mlp.biases(), [](float b) { return b == 0.0f; }));
+
+    yam::initialize(mlp, yam::Initialization::He, 1);
+    const auto last = mlp.weights().last(400 * 10);
+    const auto square = std::ranges::fold_left(last, 0.0, [](double sum, float w) { return sum + w * w; });
+    ASSERT_NEAR(std::sqrt(square / last.size()), std::sqrt(2.0 / 400), 0.005);
+}
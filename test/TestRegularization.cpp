@@ -0,0 +1,95 @@
+#include <YetAnotherMlp/Dataset.hpp>
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/Regularization.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(TestRegularization, foldedPerceptronMatchesNormalizedForward) {
+    auto mlp = yam::MLPerceptron({5, 7, 6, 3}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    auto random = yam::Random(4);
+    random(-1.0f, 1.0f, mlp.weights());
+    random(-1.0f, 1.0f, mlp.biases());
+
+    // momentum 0 keeps statistics as they are set
+    auto norm = yam::BatchNorm(mlp.topology(), 0.0f);
+    random(0.5f, 2.0f, norm.gamma);
+    random(-0.5f, 0.5f, norm.beta);
+    random(-0.5f, 0.5f, norm.mean);
+    random(0.5f, 3.0f, norm.variance);
+
+    auto folded = mlp;
+    norm.fold(mlp, folded);
+
+    auto input = std::vector<float>(5);
+    random(0.0f, 1.0f, input);
+
+    auto neurons = std::vector<float>(7 + 6 + 3);
+    mlp.forward(0, input.data(), neurons.data(), false);
+    norm.forward(1, {neurons.data(), 7});
+    mlp.activation(0)({neurons.data(), 7}, neurons.data());
+
+    mlp.forward(1, neurons.data(), neurons.data() + 7, false);
+    norm.forward(2, {neurons.data() + 7, 6});
+    mlp.activation(1)({neurons.data() + 7, 6}, neurons.data() + 7);
+
+    mlp.forward(2, neurons.data() + 7, neurons.data() + 13);
+
+    const auto actual = folded.forward(input.data());
+    for (auto n = 0; n < 3; ++n) {
+        ASSERT_NEAR(actual[n], neurons[13 + n], 1e-5f);
+    }
+}
+
+TEST(TestRegularization, dropoutMaskKeepsExpectedFraction) {
+    const auto dropout = yam::Dropout { .rate = 0.3f };
+    auto scales = std::vector<float>(100003);
+    dropout.mask(scales, 17);
+
+    const auto dropped = std::ranges::count(scales, 0.0f);
+    ASSERT_NEAR(float(dropped) / scales.size(), 0.3f, 0.01f);
+    ASSERT_NEAR(std::ranges::fold_left(scales, 0.0, std::plus<>{}) / scales.size(), 1.0, 0.02);
+
+    // masks depend on the key only
+    auto again = std::vector<float>(scales.size());
+    dropout.mask(again, 17);
+    ASSERT_EQ(again, scales);
+}
+
+TEST(TestRegularization, learningXorWithBatchNormAndDropout) {
+    const auto input = std::vector {
+        1.0f, 0.0f,
+        0.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+    const auto expected = std::vector {
+        1.0f,
+        0.0f,
+        1.0f,
+        0.0f
+    };
+
+    const auto dataset = yam::Dataset(input, expected, 4);
+    const auto mlp = yam::MLPerceptron({2, 16, 1}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    for (const auto options : {
+        yam::MLPTrainer::Options { .seed = 1, .batchNorm = true },
+        yam::MLPTrainer::Options { .seed = 1, .dropout = 0.1f },
+        yam::MLPTrainer::Options { .seed = 1, .batchNorm = true, .dropout = 0.1f }
+    }) {
+        auto trainer = yam::MLPTrainer(mlp, 0.1, 0.02, 5000, dataset, dataset, options);
+        const auto result = trainer.train();
+
+        ASSERT_LE(result.error, 0.02) << options.batchNorm << " " << options.dropout;
+    }
+}
@@ -0,0 +1,61 @@
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/Serving.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+TEST(TestServing, HistogramPercentiles) {
+    auto histogram = yam::LatencyHistogram();
+    ASSERT_EQ(histogram.percentile(0.5).count(), 0);
+
+    for (auto us = 1; us <= 1000; ++us) {
+        histogram.record(std::chrono::microseconds(us));
+    }
+
+    ASSERT_EQ(histogram.count(), 1000u);
+
+    for (const auto p : {0.01, 0.5, 0.9, 0.99}) {
+        const auto expected = p * 1000.0;
+        const auto actual = std::chrono::duration<double, std::micro>(histogram.percentile(p)).count();
+        ASSERT_GE(actual, expected * 0.99) << p;
+        ASSERT_LE(actual, expected * 1.125) << p;
+    }
+
+    histogram.reset();
+    ASSERT_EQ(histogram.count(), 0u);
+}
+
+TEST(TestServing, BatcherMatchesForward) {
+    auto mlp = yam::MLPerceptron({6, 10, 4}, true, {yam::ActivationFunctionType::Sigmoid});
+    auto random = yam::Random(9);
+    random(-1.0f, 1.0f, mlp.weights());
+    random(-1.0f, 1.0f, mlp.biases());
+
+    auto inputs = std::vector<float>(64 * 6);
+    random(0.0f, 1.0f, inputs);
+
+    auto batcher = yam::Batcher(mlp, {.maxBatch = 8, .maxDelay = std::chrono::microseconds(500), .threads = 2});
+
+    auto clients = std::vector<std::thread>();
+    auto outputs = std::vector<std::vector<float>>(64);
+    for (auto c = 0; c < 8; ++c) {
+        clients.emplace_back([&, c] {
+            for (auto i = c; i < 64; i += 8) {
+                outputs[i] = batcher.predict(std::span(inputs).subspan(i * 6, 6));
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    for (auto i = 0; i < 64; ++i) {
+        const auto expected = mlp.forward(inputs.data() + i * 6);
+        ASSERT_TRUE(std::ranges::equal(outputs[i], expected)) << i;
+    }
+
+    ASSERT_EQ(batcher.requests(), 64u);
+    ASSERT_EQ(batcher.latencies().count(), 64u);
+    ASSERT_LE(batcher.batches(), 64u);
+}
@@ -0,0 +1,97 @@
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/Simd.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+const auto isas = { yam::Isa::Sse4, yam::Isa::Avx2, yam::Isa::Avx512 };
+
+auto randomValues(int size, std::uint32_t seed) -> std::vector<float> {
+    auto values = std::vector<float>(size);
+    auto random = yam::Random(seed);
+    random(-1.0f, 1.0f, values);
+    return values;
+}
+
+}
+
+// sizes cover empty inputs, tails shorter than every width and several
+// unrolled iterations
+TEST(TestSimd, EveryIsaMatchesScalarReference) {
+    const auto& scalar = yam::Simd::kernels(yam::Isa::Scalar);
+
+    for (const auto isa : isas) {
+        if (!yam::Simd::supported(isa)) {
+            std::cout << "isa " << static_cast<int>(isa) << " not supported, skipped\n";
+            continue;
+        }
+
+        const auto& kernels = yam::Simd::kernels(isa);
+        ASSERT_EQ(kernels.isa, isa);
+
+        for (auto size = 0; size <= 100; ++size) {
+            const auto a = randomValues(size, size);
+            const auto b = randomValues(size, size + 1000);
+            const auto tolerance = 1e-5f * (size + 1);
+
+            ASSERT_NEAR(kernels.dot(a.data(), b.data(), size), scalar.dot(a.data(), b.data(), size), tolerance);
+            ASSERT_NEAR(kernels.distance(a.data(), b.data(), size), scalar.distance(a.data(), b.data(), size), tolerance);
+
+            auto expected = b;
+            auto actual = b;
+            scalar.axpy(0.3f, a.data(), expected.data(), size);
+            kernels.axpy(0.3f, a.data(), actual.data(), size);
+            for (auto i = 0; i < size; ++i) {
+                ASSERT_NEAR(actual[i], expected[i], 1e-6f);
+            }
+
+            expected = b;
+            actual = b;
+            scalar.multiply(a.data(), expected.data(), size);
+            kernels.multiply(a.data(), actual.data(), size);
+            ASSERT_EQ(actual, expected);
+        }
+
+        for (const auto [rows, cols] : { std::pair(0, 5), std::pair(3, 7), std::pair(4, 16), std::pair(13, 37), std::pair(64, 100) }) {
+            const auto matrix = randomValues(rows * cols, rows);
+            const auto vector = randomValues(rows, cols);
+
+            auto expected = std::vector<float>(cols, 1.0f);
+            auto actual = std::vector<float>(cols, 1.0f);
+            scalar.transposedMatmul(matrix.data(), vector.data(), expected.data(), rows, cols);
+            kernels.transposedMatmul(matrix.data(), vector.data(), actual.data(), rows, cols);
+            for (auto c = 0; c < cols; ++c) {
+                ASSERT_NEAR(actual[c], expected[c], 1e-5f * (rows + 1));
+            }
+        }
+    }
+}
+
+TEST(TestSimd, SelectedIsaIsUsedByForward) {
+    auto mlp = yam::MLPerceptron({37, 19, 5}, true, { yam::ActivationFunctionType::Sigmoid });
+    auto random = yam::Random(7);
+    random(-1.0f, 1.0f, mlp.weights());
+    random(-1.0f, 1.0f, mlp.biases());
+    const auto input = randomValues(37, 8);
+
+    const auto best = yam::Simd::best();
+    ASSERT_EQ(yam::Simd::active().isa, best);
+
+    ASSERT_TRUE(yam::Simd::select(yam::Isa::Scalar));
+    ASSERT_EQ(yam::Simd::active().isa, yam::Isa::Scalar);
+    const auto forward = mlp.forward(input.data());
+    const auto reference = std::vector<float>(forward.begin(), forward.end());
+
+    for (const auto isa : isas) {
+        if (yam::Simd::select(isa)) {
+            const auto output = mlp.forward(input.data());
+            for (auto o = 0u; o < output.size(); ++o) {
+                ASSERT_NEAR(output[o], reference[o], 1e-5f);
+            }
+        }
+    }
+
+    ASSERT_TRUE(yam::Simd::select(best));
+}
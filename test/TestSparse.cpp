@@ -0,0 +1,65 @@
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/Sparse.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(TestSparse, CsrMultiply) {
+    const auto dense = std::vector {
+        1.0f, 0.0f, 2.0f,
+        0.0f, 0.0f, 0.0f,
+        0.0f, 3.0f, 0.0f
+    };
+    const auto matrix = yam::CsrMatrix(dense, 3, 3);
+    const auto vector = std::vector { 1.0f, 2.0f, 3.0f };
+
+    auto result = std::vector<float>(3);
+    matrix.multiply(vector.data(), result.data());
+
+    ASSERT_EQ(matrix.nonzeros(), 3);
+    ASSERT_FLOAT_EQ(result[0], 7.0f);
+    ASSERT_FLOAT_EQ(result[1], 0.0f);
+    ASSERT_FLOAT_EQ(result[2], 6.0f);
+}
+
+TEST(TestSparse, PruneFraction) {
+    auto mlp = yam::MLPerceptron({10, 10, 2}, true, {yam::ActivationFunctionType::Sigmoid});
+    yam::Random(7)(-1.0f, 1.0f, mlp.weights());
+
+    yam::pruneFraction(mlp, 0.75f);
+
+    ASSERT_EQ(std::ranges::count(mlp.weights().first(100), 0.0f), 75);
+    ASSERT_EQ(std::ranges::count(mlp.weights().last(20), 0.0f), 15);
+}
+
+TEST(TestSparse, SparseForwardMatchesDense) {
+    auto mlp = yam::MLPerceptron({16, 8, 4}, true, {
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    auto random = yam::Random(3);
+    random(-1.0f, 1.0f, mlp.weights());
+    random(-1.0f, 1.0f, mlp.biases());
+    yam::pruneFraction(mlp, 0.5f);
+
+    auto sparse = yam::SparseMLPerceptron(mlp);
+
+    auto inputs = std::vector<float>(16 * 3);
+    random(0.0f, 1.0f, inputs);
+
+    const auto outputs = sparse.forward(inputs.data(), 3);
+    const auto batch = std::vector<float>(outputs.begin(), outputs.end());
+
+    for (auto i = 0; i < 3; ++i) {
+        const auto expected = mlp.forward(inputs.data() + i * 16);
+        const auto actual = sparse.forward(inputs.data() + i * 16);
+
+        for (auto o = 0; o < 4; ++o) {
+            ASSERT_NEAR(actual[o], expected[o], 1e-6);
+            ASSERT_NEAR(batch[i * 4 + o], expected[o], 1e-6);
+        }
+    }
+
+    ASSERT_NEAR(sparse.sparsity(), 0.5f, 1e-6);
+}
@@ -0,0 +1,46 @@
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/StaticMLPerceptron.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+TEST(TestStaticMLPerceptron, MatchesRuntimePerceptron) {
+    auto mlp = yam::MLPerceptron({20, 13, 3}, true, {
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    auto random = yam::Random(9);
+    random(-1.0f, 1.0f, mlp.weights());
+    random(-1.0f, 1.0f, mlp.biases());
+
+    using Activations = std::tuple<yam::Activation::Relu, yam::Activation::Sigmoid>;
+    auto fixed = std::make_unique<yam::StaticMLPerceptron<Activations, true, 20, 13, 3>>();
+
+    ASSERT_TRUE(fixed->load(mlp));
+
+    auto input = std::vector<float>(20);
+    random(-1.0f, 1.0f, input);
+
+    const auto expected = mlp.forward(input.data());
+    const auto actual = fixed->forward(input.data());
+
+    ASSERT_EQ(actual.size(), 3);
+    for (auto o = 0; o < 3; ++o) {
+        ASSERT_NEAR(actual[o], expected[o], 1e-5);
+    }
+}
+
+TEST(TestStaticMLPerceptron, RejectsDifferentTopology) {
+    const auto mlp = yam::MLPerceptron({4, 2}, false, {yam::ActivationFunctionType::Linear});
+
+    auto withBias = yam::StaticMLPerceptron<yam::Activation::Linear, true, 4, 2>();
+    auto wider = yam::StaticMLPerceptron<yam::Activation::Linear, false, 4, 3>();
+    auto same = yam::StaticMLPerceptron<yam::Activation::Linear, false, 4, 2>();
+
+    ASSERT_FALSE(withBias.load(mlp));
+    ASSERT_FALSE(wider.load(mlp));
+    ASSERT_TRUE(same.load(mlp));
+}
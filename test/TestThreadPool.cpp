@@ -0,0 +1,67 @@
+#include <YetAnotherMlp/ThreadPool.hpp>
+#include <YetAnotherMlp/Utils.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+TEST(TestThreadPool, ParallelForVisitsEveryIndexOnce) {
+    auto pool = yam::ThreadPool(4);
+    auto visits = std::vector<std::atomic<int>>(1000);
+
+    pool.parallelFor(0, visits.size(), 7, [&](int first, int last) {
+        for (auto i = first; i < last; ++i) {
+            visits[i]++;
+        }
+    });
+
+    ASSERT_TRUE(std::ranges::all_of(visits, [](auto& v) { return v == 1; }));
+}
+
+TEST(TestThreadPool, NestedParallelFor) {
+    auto pool = yam::ThreadPool(3);
+    auto sums = std::vector<int>(50);
+
+    pool.parallelFor(0, sums.size(), 1, [&](int first, int last) {
+        for (auto i = first; i < last; ++i) {
+            auto sum = std::atomic<int>(0);
+            pool.parallelFor(0, 100, 10, [&](int f, int l) {
+                for (auto j = f; j < l; ++j) {
+                    sum += j;
+                }
+            });
+            sums[i] = sum;
+        }
+    });
+
+    ASSERT_TRUE(std::ranges::all_of(sums, [](auto s) { return s == 4950; }));
+}
+
+TEST(TestThreadPool, ReduceDoesNotDependOnThreads) {
+    auto values = std::vector<float>(10000);
+    for (auto i = 0; i < values.size(); ++i) {
+        values[i] = 1.0f / (i + 1);
+    }
+
+    const auto reduce = [&](yam::ThreadPool& pool) {
+        return pool.parallelReduce(0, values.size(), 128, 0.0f, [&](int first, int last) {
+            return std::accumulate(values.begin() + first, values.begin() + last, 0.0f);
+        }, std::plus<>{});
+    };
+
+    auto single = yam::ThreadPool(1);
+    auto many = yam::ThreadPool(5);
+
+    ASSERT_EQ(reduce(single), reduce(many));
+}
+
+TEST(TestThreadPool, PerWorkerCopies) {
+    auto pool = yam::ThreadPool(4);
+    auto counters = yam::PerWorker<int>(pool, 0);
+
+    pool.parallelFor(0, 1000, 10, [&](int first, int last) {
+        counters.local() += last - first;
+    });
+
+    ASSERT_EQ(yam::sum(counters.items()), 1000);
+}
@@ -0,0 +1,115 @@
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/Transform.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(TestTransform, NormalizeAndStandardize) {
+    auto random = yam::SampleRandom(0);
+
+    auto values = std::vector { 0.0f, 128.0f, 256.0f };
+    yam::Normalize { 0, 256 }(values, random);
+    ASSERT_EQ(values, (std::vector { 0.0f, 0.5f, 1.0f }));
+
+    const auto dataset = yam::Dataset({1, 5, 3, 5, 5, 5}, {0, 0, 0}, 3);
+    const auto standardize = yam::Standardize::fit(dataset);
+
+    auto mean = std::vector<float>(2);
+    auto square = std::vector<float>(2);
+    for (auto i = 0; i < dataset.size(); ++i) {
+        auto input = std::vector(dataset.input(i).begin(), dataset.input(i).end());
+        standardize(input, random);
+        for (auto n = 0; n < 2; ++n) {
+            mean[n] += input[n] / 3;
+            square[n] += input[n] * input[n] / 3;
+        }
+    }
+
+    ASSERT_NEAR(mean[0], 0.0f, 1e-5f);
+    ASSERT_NEAR(square[0], 1.0f, 1e-5f);
+    // constant input is only centered
+    ASSERT_NEAR(mean[1], 0.0f, 1e-5f);
+    ASSERT_NEAR(square[1], 0.0f, 1e-5f);
+}
+
+TEST(TestTransform, ShiftMatchesReference) {
+    const auto width = 7;
+    const auto height = 5;
+
+    auto image = std::vector<float>(width * height);
+    for (auto i = 0u; i < image.size(); ++i) {
+        image[i] = i + 1;
+    }
+
+    for (auto key = 0u; key < 200; ++key) {
+        // the same random choices as the shift makes
+        auto random = yam::SampleRandom(key);
+        const auto dx = random(-3, 3);
+        const auto dy = random(-3, 3);
+
+        auto expected = std::vector<float>(image.size());
+        for (auto y = 0; y < height; ++y) {
+            for (auto x = 0; x < width; ++x) {
+                const auto sx = x - dx;
+                const auto sy = y - dy;
+                if (sx >= 0 && sx < width && sy >= 0 && sy < height) {
+                    expected[y * width + x] = image[sy * width + sx];
+                }
+            }
+        }
+
+        auto shifted = image;
+        yam::Transforms(yam::Shift { width, height, 3 })(shifted, key);
+        ASSERT_EQ(shifted, expected) << dx << ", " << dy;
+    }
+}
+
+TEST(TestTransform, AugmentationsAreSkippedInEvaluation) {
+    const auto transforms = yam::Transforms(yam::Noise { 1.0f }, yam::Normalize { 0, 2 });
+    ASSERT_TRUE(transforms.evaluated());
+    ASSERT_FALSE(yam::Transforms(yam::Noise { 1.0f }).evaluated());
+
+    auto values = std::vector { 1.0f, 2.0f };
+    transforms(values, 5, false);
+    ASSERT_EQ(values, (std::vector { 0.5f, 1.0f }));
+
+    auto first = std::vector { 1.0f, 2.0f };
+    auto second = first;
+    transforms(first, 5);
+    transforms(second, 5);
+    ASSERT_EQ(first, second);
+    ASSERT_NE(first, (std::vector { 0.5f, 1.0f }));
+}
+
+TEST(TestTransform, TransformedTrainingIsReproducibleAcrossThreads) {
+    auto inputs = std::vector<float>(1000 * 16);
+    auto outputs = std::vector<float>(1000 * 2);
+    auto random = yam::Random(2);
+    random(0.0f, 1.0f, inputs);
+    random(0.0f, 1.0f, outputs);
+
+    const auto dataset = yam::Dataset(inputs, outputs, 1000);
+    const auto mlp = yam::MLPerceptron({16, 8, 2}, true, {yam::ActivationFunctionType::Sigmoid});
+
+    const auto train = [&](yam::ThreadPool* pool, yam::Shuffling shuffling) {
+        auto trainer = yam::MLPTrainer(mlp, 0.1, 0.0, 3, dataset, dataset, {
+            .pool = pool,
+            .shuffling = shuffling,
+            .seed = 4,
+            .transforms = yam::Transforms(
+                yam::Shift { 4, 4, 1 },
+                yam::Noise { 0.1f },
+                yam::Standardize::fit(dataset)
+            )
+        });
+
+        const auto error = trainer.train().error;
+        const auto weights = trainer.trainee().weights();
+        return std::make_pair(error, std::vector<float>(weights.begin(), weights.end()));
+    };
+
+    auto pool = yam::ThreadPool(4);
+
+    ASSERT_EQ(train(nullptr, yam::Shuffling::Staged), train(&pool, yam::Shuffling::Staged));
+    ASSERT_EQ(train(nullptr, yam::Shuffling::Samples), train(&pool, yam::Shuffling::Samples));
+}
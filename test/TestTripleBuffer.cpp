@@ -0,0 +1,55 @@
+#include <YetAnotherMlp/TripleBuffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST(TestTripleBuffer, ReaderGetsLatestPublished) {
+    auto buffer = yam::TripleBuffer<int>(0);
+
+    ASSERT_FALSE(buffer.update());
+    ASSERT_EQ(buffer.front(), 0);
+
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(buffer.front(), 2);
+    ASSERT_FALSE(buffer.update());
+    ASSERT_EQ(buffer.front(), 2);
+
+    buffer.back() = 3;
+    buffer.publish();
+
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(buffer.front(), 3);
+}
+
+TEST(TestTripleBuffer, SnapshotsAreNeverTorn) {
+    auto buffer = yam::TripleBuffer<std::vector<int>>(std::vector<int>(1000, 0));
+    const auto published = 20000;
+
+    auto writer = std::thread([&] {
+        for (auto value = 1; value <= published; ++value) {
+            std::ranges::fill(buffer.back(), value);
+            buffer.publish();
+        }
+    });
+
+    auto last = 0;
+    while (last < published) {
+        if (!buffer.update()) {
+            continue;
+        }
+
+        const auto& snapshot = buffer.front();
+        ASSERT_TRUE(std::ranges::all_of(snapshot, [&](int v) { return v == snapshot.front(); }));
+        ASSERT_GT(snapshot.front(), last);
+        last = snapshot.front();
+    }
+
+    writer.join();
+}
@@ -0,0 +1,91 @@
+#include <YetAnotherMlp/Dataset.hpp>
+#include <YetAnotherMlp/Mathematics.hpp>
+#include <YetAnotherMlp/MLPerceptron.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/WeightLayout.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(TestWeightLayout, panelsMatchRowMajorProducts) {
+    const auto topology = std::vector { 13, 19, 8, 3 };
+    auto mlp = yam::MLPerceptron(topology, false, {yam::ActivationFunctionType::Linear});
+
+    auto random = yam::Random(8);
+    random(-1.0f, 1.0f, mlp.weights());
+
+    auto panels = yam::PanelWeights(topology);
+    panels.pack(mlp.weights());
+
+    auto unpacked = std::vector<float>(mlp.weights().size());
+    panels.unpack(unpacked);
+    ASSERT_TRUE(std::ranges::equal(unpacked, mlp.weights()));
+
+    auto weight = mlp.weights().begin().base();
+    for (auto layer = 0; layer < 3; ++layer) {
+        const auto lc = topology[layer];
+        const auto uc = topology[layer + 1];
+
+        auto lower = std::vector<float>(lc);
+        auto upper = std::vector<float>(uc);
+        random(-1.0f, 1.0f, lower);
+        random(-1.0f, 1.0f, upper);
+
+        auto expected = std::vector<float>(uc);
+        mlp.forward(layer, lower.data(), expected.data());
+        auto actual = std::vector<float>(uc);
+        panels.forward(layer, lower.data(), actual.data());
+        for (auto u = 0; u < uc; ++u) {
+            ASSERT_NEAR(actual[u], expected[u], 1e-5f);
+        }
+
+        auto transposed = std::vector<float>(lc);
+        yam::transposedMatmul(weight, upper.data(), transposed.data(), uc, lc);
+        auto panelTransposed = std::vector<float>(lc);
+        panels.transposed(layer, upper.data(), panelTransposed.data());
+        for (auto l = 0; l < lc; ++l) {
+            auto sum = 0.0f;
+            for (auto u = 0; u < uc; ++u) {
+                sum += weight[u * lc + l] * upper[u];
+            }
+            ASSERT_NEAR(transposed[l], sum, 1e-5f);
+            ASSERT_NEAR(panelTransposed[l], sum, 1e-5f);
+        }
+
+        weight += lc * uc;
+    }
+}
+
+TEST(TestWeightLayout, trainingOnPanelsMatchesRowMajor) {
+    auto inputs = std::vector<float>(200 * 11);
+    auto outputs = std::vector<float>(200 * 3);
+    auto random = yam::Random(6);
+    random(0.0f, 1.0f, inputs);
+    random(0.0f, 1.0f, outputs);
+
+    const auto dataset = yam::Dataset(inputs, outputs, 200);
+    const auto mlp = yam::MLPerceptron({11, 20, 9, 3}, true, {
+        yam::ActivationFunctionType::Tanh,
+        yam::ActivationFunctionType::Relu,
+        yam::ActivationFunctionType::Sigmoid
+    });
+
+    const auto train = [&](yam::WeightLayout layout) {
+        auto trainer = yam::MLPTrainer(mlp, 0.05, 0.0, 3, dataset, dataset, {
+            .seed = 4,
+            .weightLayout = layout
+        });
+        const auto error = trainer.train().error;
+        const auto weights = trainer.trainee().weights();
+        return std::make_pair(error, std::vector<float>(weights.begin(), weights.end()));
+    };
+
+    const auto [rowMajorError, rowMajorWeights] = train(yam::WeightLayout::RowMajor);
+    const auto [panelsError, panelsWeights] = train(yam::WeightLayout::Panels);
+
+    // only summation orders differ
+    ASSERT_NEAR(panelsError, rowMajorError, 1e-4f);
+    for (auto w = 0u; w < rowMajorWeights.size(); ++w) {
+        ASSERT_NEAR(panelsWeights[w], rowMajorWeights[w], 1e-3f) << w;
+    }
+}
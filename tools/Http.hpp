@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Just enough HTTP/1.1 over blocking sockets for yam-serve and yam-loadgen:
+// Content-Length bodies and keep-alive connections.
+namespace http {
+
+inline constexpr auto maxHeader = std::size_t(64 * 1024);
+inline constexpr auto maxBody = std::size_t(64 * 1024 * 1024);
+
+struct Message {
+    std::string start;
+    std::string body;
+    bool close = false;
+};
+
+inline auto address(const char* host, int port) -> sockaddr_in {
+    auto address = sockaddr_in();
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    ::inet_pton(AF_INET, host, &address.sin_addr);
+    return address;
+}
+
+inline auto noDelay(int socket) -> void {
+    const auto enable = 1;
+    ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+}
+
+inline auto sendAll(int socket, std::string_view data) -> bool {
+    while (!data.empty()) {
+        const auto sent = ::send(socket, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        data.remove_prefix(sent);
+    }
+    return true;
+}
+
+// reads one message, buffer keeps bytes of the following ones
+inline auto receive(int socket, std::string& buffer) -> std::optional<Message> {
+    auto chunk = std::array<char, 16 * 1024>();
+
+    const auto fill = [&] {
+        const auto read = ::recv(socket, chunk.data(), chunk.size(), 0);
+        if (read <= 0) {
+            return false;
+        }
+        buffer.append(chunk.data(), read);
+        return true;
+    };
+
+    auto end = buffer.find("\r\n\r\n");
+    while (end == std::string::npos) {
+        if (buffer.size() > maxHeader || !fill()) {
+            return std::nullopt;
+        }
+        end = buffer.find("\r\n\r\n");
+    }
+
+    const auto header = std::string_view(buffer).substr(0, end);
+    auto message = Message { .start = std::string(header.substr(0, header.find("\r\n"))) };
+
+    auto length = std::size_t(0);
+    for (auto line = header.find("\r\n"); line != std::string_view::npos; ) {
+        const auto next = header.find("\r\n", line + 2);
+        const auto field = header.substr(line + 2, next == std::string_view::npos ? next : next - line - 2);
+        line = next;
+
+        const auto colon = field.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+
+        auto name = std::string(field.substr(0, colon));
+        for (auto& c : name) {
+            c = std::tolower(c);
+        }
+        auto value = field.substr(colon + 1);
+        value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+
+        if (name == "content-length") {
+            std::from_chars(value.data(), value.data() + value.size(), length);
+        } else if (name == "connection") {
+            message.close = value == "close";
+        }
+    }
+
+    if (length > maxBody) {
+        return std::nullopt;
+    }
+
+    while (buffer.size() < end + 4 + length) {
+        if (!fill()) {
+            return std::nullopt;
+        }
+    }
+
+    message.body = buffer.substr(end + 4, length);
+    buffer.erase(0, end + 4 + length);
+    return message;
+}
+
+inline auto request(std::string_view method, std::string_view path, std::string_view body) -> std::string {
+    auto message = std::string(method);
+    message += " ";
+    message += path;
+    message += " HTTP/1.1\r\nHost: localhost\r\nContent-Length: ";
+    message += std::to_string(body.size());
+    message += "\r\n\r\n";
+    message += body;
+    return message;
+}
+
+inline auto response(std::string_view status, std::string_view body) -> std::string {
+    auto message = std::string("HTTP/1.1 ");
+    message += status;
+    message += "\r\nContent-Type: text/plain\r\nContent-Length: ";
+    message += std::to_string(body.size());
+    message += "\r\n\r\n";
+    message += body;
+    return message;
+}
+
+// comma or whitespace separated floats
+inline auto parse(std::string_view text) -> std::optional<std::vector<float>> {
+    auto values = std::vector<float>();
+    auto first = text.data();
+    const auto last = text.data() + text.size();
+
+    while (true) {
+        while (first != last && (*first == ',' || std::isspace(static_cast<unsigned char>(*first)))) {
+            ++first;
+        }
+        if (first == last) {
+            return values;
+        }
+
+        auto value = 0.0f;
+        const auto [next, error] = std::from_chars(first, last, value);
+        if (error != std::errc()) {
+            return std::nullopt;
+        }
+        values.push_back(value);
+        first = next;
+    }
+}
+
+inline auto format(std::span<const float> values) -> std::string {
+    auto text = std::string();
+    auto number = std::array<char, 32>();
+    for (const auto value : values) {
+        const auto end = std::to_chars(number.data(), number.data() + number.size(), value).ptr;
+        text.append(text.empty() ? "" : ",").append(number.data(), end);
+    }
+    return text;
+}
+
+}
@@ -0,0 +1,126 @@
+#include "Http.hpp"
+
+#include <YetAnotherMlp/Random.hpp>
+#include <YetAnotherMlp/Serving.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// yam-loadgen inputs [--port 8080] [--seconds 5] [--connections 1,2,4,8,16,32]
+//
+// Closed loop clients, each on its own keep-alive connection sends random
+// inputs to /predict as soon as the previous answer came. Every connection
+// count is one point of the throughput against latency curve.
+
+namespace {
+
+auto connect(int port) -> int {
+    const auto socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    const auto address = http::address("127.0.0.1", port);
+    if (::connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(socket);
+        return -1;
+    }
+    http::noDelay(socket);
+    return socket;
+}
+
+}
+
+auto main(int argc, char** argv) -> int {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " inputs [--port 8080] [--seconds 5] [--connections 1,2,4,8,16,32]\n";
+        return 1;
+    }
+
+    const auto inputs = std::atoi(argv[1]);
+    auto port = 8080;
+    auto seconds = 5;
+    auto levels = std::vector<int> { 1, 2, 4, 8, 16, 32 };
+
+    for (auto a = 2; a + 1 < argc; a += 2) {
+        if (std::strcmp(argv[a], "--port") == 0) {
+            port = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--seconds") == 0) {
+            seconds = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--connections") == 0) {
+            levels.clear();
+            for (auto level = argv[a + 1]; *level; ) {
+                levels.push_back(std::strtol(level, &level, 10));
+                level += *level == ',';
+            }
+        } else {
+            std::cerr << "unknown option " << argv[a] << "\n";
+            return 1;
+        }
+    }
+
+    auto random = yam::Random(1);
+    auto bodies = std::vector<std::string>(64);
+    for (auto& body : bodies) {
+        auto values = std::vector<float>(inputs);
+        random(0.0f, 1.0f, values);
+        body = http::request("POST", "/predict", http::format(values));
+    }
+
+    std::cout << std::setw(12) << "connections"
+              << std::setw(14) << "requests/s"
+              << std::setw(12) << "p50 [us]"
+              << std::setw(12) << "p99 [us]"
+              << std::setw(10) << "errors" << "\n";
+
+    for (const auto connections : levels) {
+        auto latencies = yam::LatencyHistogram();
+        auto errors = std::atomic<int>(0);
+        auto stop = std::atomic<bool>(false);
+
+        auto clients = std::vector<std::thread>();
+        for (auto c = 0; c < connections; ++c) {
+            clients.emplace_back([&, c] {
+                const auto socket = connect(port);
+                if (socket < 0) {
+                    errors++;
+                    return;
+                }
+
+                auto buffer = std::string();
+                for (auto r = c; !stop.load(std::memory_order_relaxed); ++r) {
+                    const auto start = std::chrono::steady_clock::now();
+                    if (!http::sendAll(socket, bodies[r % bodies.size()])) {
+                        errors++;
+                        break;
+                    }
+                    const auto answer = http::receive(socket, buffer);
+                    if (!answer || !answer->start.starts_with("HTTP/1.1 200")) {
+                        errors++;
+                        break;
+                    }
+                    latencies.record(std::chrono::steady_clock::now() - start);
+                }
+                ::close(socket);
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        stop = true;
+        for (auto& client : clients) {
+            client.join();
+        }
+
+        const auto micros = [&](double p) {
+            return std::chrono::duration<double, std::micro>(latencies.percentile(p)).count();
+        };
+
+        std::cout << std::setw(12) << connections
+                  << std::setw(14) << double(latencies.count()) / seconds
+                  << std::setw(12) << micros(0.5)
+                  << std::setw(12) << micros(0.99)
+                  << std::setw(10) << errors.load() << "\n";
+    }
+}
@@ -0,0 +1,124 @@
+#include "Http.hpp"
+
+#include <YetAnotherMlp/Model.hpp>
+#include <YetAnotherMlp/Serving.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// yam-serve model [--port 8080] [--threads 1] [--batch 32] [--delay-us 200]
+//
+//   POST /predict      comma separated inputs, responds with outputs
+//   GET  /stats        served requests, batches and latency percentiles
+//   POST /stats/reset  clears the statistics
+
+namespace {
+
+auto stats(const yam::Batcher& batcher) -> std::string {
+    const auto& latencies = batcher.latencies();
+    const auto micros = [&](double p) {
+        return std::chrono::duration<double, std::micro>(latencies.percentile(p)).count();
+    };
+
+    auto text = std::ostringstream();
+    text << "requests " << batcher.requests() << "\n"
+         << "batches " << batcher.batches() << "\n"
+         << "mean_batch " << double(batcher.requests()) / std::max<std::uint64_t>(batcher.batches(), 1) << "\n"
+         << "p50_us " << micros(0.5) << "\n"
+         << "p99_us " << micros(0.99) << "\n"
+         << "p999_us " << micros(0.999) << "\n";
+    return text.str();
+}
+
+auto serve(int socket, yam::Batcher& batcher, int inputs) -> void {
+    auto buffer = std::string();
+
+    while (const auto message = http::receive(socket, buffer)) {
+        auto reply = std::string();
+
+        if (message->start.starts_with("POST /predict ")) {
+            const auto values = http::parse(message->body);
+            if (values && static_cast<int>(values->size()) == inputs) {
+                reply = http::response("200 OK", http::format(batcher.predict(*values)));
+            } else {
+                reply = http::response("400 Bad Request", "expected " + std::to_string(inputs) + " inputs\n");
+            }
+        } else if (message->start.starts_with("GET /stats ")) {
+            reply = http::response("200 OK", stats(batcher));
+        } else if (message->start.starts_with("POST /stats/reset ")) {
+            batcher.latencies().reset();
+            reply = http::response("200 OK", "");
+        } else {
+            reply = http::response("404 Not Found", "");
+        }
+
+        if (!http::sendAll(socket, reply) || message->close) {
+            break;
+        }
+    }
+
+    ::close(socket);
+}
+
+}
+
+auto main(int argc, char** argv) -> int {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " model [--port 8080] [--threads 1] [--batch 32] [--delay-us 200]\n";
+        return 1;
+    }
+
+    auto port = 8080;
+    auto options = yam::BatcherOptions();
+
+    for (auto a = 2; a + 1 < argc; a += 2) {
+        const auto value = std::atoi(argv[a + 1]);
+        if (std::strcmp(argv[a], "--port") == 0) {
+            port = value;
+        } else if (std::strcmp(argv[a], "--threads") == 0) {
+            options.threads = value;
+        } else if (std::strcmp(argv[a], "--batch") == 0) {
+            options.maxBatch = value;
+        } else if (std::strcmp(argv[a], "--delay-us") == 0) {
+            options.maxDelay = std::chrono::microseconds(value);
+        } else {
+            std::cerr << "unknown option " << argv[a] << "\n";
+            return 1;
+        }
+    }
+
+    const auto mlp = yam::Model::load(argv[1]);
+    if (!mlp) {
+        std::cerr << "cannot load model " << argv[1] << "\n";
+        return 1;
+    }
+
+    auto batcher = yam::Batcher(*mlp, options);
+
+    const auto listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    const auto enable = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    const auto address = http::address("127.0.0.1", port);
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "cannot listen on port " << port << "\n";
+        return 1;
+    }
+
+    std::cout << "serving " << argv[1] << " on 127.0.0.1:" << port << std::endl;
+
+    const auto inputs = mlp->topology().front();
+    while (true) {
+        const auto socket = ::accept(listener, nullptr, nullptr);
+        if (socket < 0) {
+            continue;
+        }
+        http::noDelay(socket);
+        std::thread([socket, &batcher, inputs] { serve(socket, batcher, inputs); }).detach();
+    }
+}
@@ -0,0 +1,202 @@
+#include <YetAnotherMlp/DatasetCache.hpp>
+#include <YetAnotherMlp/MLPTrainer.hpp>
+#include <YetAnotherMlp/Mnist.hpp>
+#include <YetAnotherMlp/Model.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// yam-train trainImages trainLabels testImages testLabels [options]
+//
+//   --hidden 100,50          sizes of hidden layers, none for a single layer
+//   --activations sigmoid    one per layer or one for all: linear, sigmoid,
+//                            bisigmoid, relu, leakyrelu, tanh
+//   --bias 1
+//   --learnrate 0.1
+//   --epochs 10
+//   --error 0                stops earlier once testset error gets this low
+//   --threads N              hardware concurrency by default
+//   --seed S                 reproducible training
+//   --output model.yam       written after every epoch
+//   --cache mnist            reuses mnist.train and mnist.test caches of the
+//                            parsed sets, they are written when missing
+
+namespace {
+
+auto integers(const char* text) -> std::vector<int> {
+    auto values = std::vector<int>();
+    for (auto next = const_cast<char*>(text); *next; ) {
+        values.push_back(std::strtol(next, &next, 10));
+        next += *next == ',';
+    }
+    return values;
+}
+
+auto activations(const char* text) -> std::optional<std::vector<yam::ActivationFunctionType>> {
+    static const auto names = std::map<std::string, yam::ActivationFunctionType, std::less<>> {
+        { "linear", yam::ActivationFunctionType::Linear },
+        { "sigmoid", yam::ActivationFunctionType::Sigmoid },
+        { "bisigmoid", yam::ActivationFunctionType::Bisigmoid },
+        { "relu", yam::ActivationFunctionType::Relu },
+        { "leakyrelu", yam::ActivationFunctionType::LeakyRelu },
+        { "tanh", yam::ActivationFunctionType::Tanh }
+    };
+
+    auto types = std::vector<yam::ActivationFunctionType>();
+    for (auto name = std::string_view(text); !name.empty(); ) {
+        const auto comma = std::min(name.find(','), name.size());
+        const auto type = names.find(name.substr(0, comma));
+        if (type == names.end()) {
+            return std::nullopt;
+        }
+        types.push_back(type->second);
+        name.remove_prefix(std::min(comma + 1, name.size()));
+    }
+
+    if (types.empty()) {
+        return std::nullopt;
+    }
+    return types;
+}
+
+}
+
+auto main(int argc, char** argv) -> int {
+    if (argc < 5) {
+        std::cerr << "usage: " << argv[0] << " trainImages trainLabels testImages testLabels"
+                  << " [--hidden 100] [--activations sigmoid] [--bias 1] [--learnrate 0.1] [--epochs 10]"
+                  << " [--error 0] [--threads N] [--seed S] [--output model.yam] [--cache prefix]\n";
+        return 1;
+    }
+
+    auto hidden = std::vector<int> { 100 };
+    auto types = std::vector { yam::ActivationFunctionType::Sigmoid };
+    auto bias = true;
+    auto learnrate = 0.1f;
+    auto epochs = 10;
+    auto error = 0.0f;
+    auto threads = static_cast<int>(std::thread::hardware_concurrency());
+    auto seed = std::optional<std::uint32_t>();
+    auto output = std::string("model.yam");
+    auto cache = std::string();
+
+    for (auto a = 5; a < argc; a += 2) {
+        const auto name = std::string_view(argv[a]);
+        if (a + 1 == argc) {
+            std::cerr << "missing value of " << name << "\n";
+            return 1;
+        }
+
+        const auto value = argv[a + 1];
+        if (name == "--hidden") {
+            hidden = integers(value);
+        } else if (name == "--activations") {
+            const auto parsed = activations(value);
+            if (!parsed) {
+                std::cerr << "unknown activation in " << value << "\n";
+                return 1;
+            }
+            types = *parsed;
+        } else if (name == "--bias") {
+            bias = std::atoi(value) != 0;
+        } else if (name == "--learnrate") {
+            learnrate = std::atof(value);
+        } else if (name == "--epochs") {
+            epochs = std::atoi(value);
+        } else if (name == "--error") {
+            error = std::atof(value);
+        } else if (name == "--threads") {
+            threads = std::atoi(value);
+        } else if (name == "--seed") {
+            seed = std::strtoul(value, nullptr, 10);
+        } else if (name == "--output") {
+            output = value;
+        } else if (name == "--cache") {
+            cache = value;
+        } else {
+            std::cerr << "unknown option " << name << "\n";
+            return 1;
+        }
+    }
+
+    const auto read = [&cache](const char* images, const char* labels, const char* suffix) {
+        if (cache.empty()) {
+            return yam::Mnist::read(images, labels);
+        }
+        return yam::DatasetCache::cached((cache + suffix).c_str(), [&] {
+            return yam::Mnist::read(images, labels);
+        });
+    };
+
+    const auto trainset = read(argv[1], argv[2], ".train");
+    const auto testset = read(argv[3], argv[4], ".test");
+    if (trainset.size() == 0 || testset.size() == 0) {
+        std::cerr << "cannot read datasets\n";
+        return 1;
+    }
+
+    auto topology = std::vector<int> { trainset.inputSize() };
+    topology.insert(topology.end(), hidden.begin(), hidden.end());
+    topology.push_back(trainset.outputSize());
+
+    if (types.size() != 1 && types.size() != topology.size() - 1) {
+        std::cerr << "expected 1 or " << topology.size() - 1 << " activations\n";
+        return 1;
+    }
+
+    auto pool = std::optional<yam::ThreadPool>();
+    if (threads > 1) {
+        pool.emplace(threads);
+    }
+
+    auto trainer = yam::MLPTrainer(
+        yam::MLPerceptron(topology, bias, types),
+        learnrate, error, epochs, trainset, testset, {
+            .pool = pool ? std::addressof(*pool) : nullptr,
+            .seed = seed
+        }
+    );
+    trainer.trainee().parallelize(pool ? std::addressof(*pool) : nullptr);
+
+    std::cout << std::setw(8) << "epoch"
+              << std::setw(12) << "error"
+              << std::setw(12) << "accuracy"
+              << std::setw(12) << "time [s]"
+              << std::setw(14) << "samples/s" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    auto saved = true;
+
+    trainer.train([&](auto&& result) {
+        const auto now = std::chrono::steady_clock::now();
+        const auto seconds = std::chrono::duration<double>(now - start).count();
+        start = now;
+
+        std::cout << std::setw(8) << result.epoch
+                  << std::setw(12) << result.error
+                  << std::setw(12) << result.evaluation.accuracy();
+
+        if (result.epoch > 0) {
+            std::cout << std::setw(12) << seconds
+                      << std::setw(14) << trainset.size() / seconds;
+            saved = yam::Model::save(*result.trainee, output.c_str());
+        }
+        std::cout << std::endl;
+    });
+
+    if (!saved) {
+        std::cerr << "cannot write " << output << "\n";
+        return 1;
+    }
+
+    std::cout << "model written to " << output << "\n";
+    return 0;
+}